@@ -0,0 +1,129 @@
+// Intake queue benchmark and determinism check. Producer threads submit orders and
+// customers at the same time; a batch drained after they are done must come out in the
+// same (producer, sequence) order in every round, however the threads interleaved.
+// A second pass drains while they are still submitting, where only each producer's
+// own order has to hold across batches.
+// usage: intake_order [producers] [requestsPerProducer] [rounds]
+
+#include "../include/IntakeQueue.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+
+// Every eighth request adds a customer, the others place an order for producer * requests + i
+static void submitAll(IntakeQueue::Producer producer, int requests, const std::atomic<bool> &go)
+{
+    while (!go.load(std::memory_order_acquire))
+    {
+    }
+    for (int i = 0; i < requests; i++)
+    {
+        if (i % 8 == 7)
+            producer.submitCustomer("intake", "soldier", 1 + i % 20, 3);
+        else
+            producer.submitOrder(producer.getId() * requests + i);
+    }
+}
+
+static vector<std::thread> startProducers(IntakeQueue &queue, int producers, int requests, const std::atomic<bool> &go)
+{
+    vector<std::thread> threads;
+    for (int p = 0; p < producers; p++)
+    {
+        // Made here, in order, so producer p has id p
+        threads.emplace_back(submitAll, queue.makeProducer(), requests, std::cref(go));
+    }
+    return threads;
+}
+
+static bool expected(const IntakeRequest &request, int producer, int i, int requests)
+{
+    if (request.producerId != producer || request.sequence != static_cast<uint64_t>(i))
+        return false;
+    if (i % 8 == 7)
+        return request.kind == IntakeKind::CUSTOMER && request.distance == 1 + i % 20;
+    return request.kind == IntakeKind::ORDER && request.customerId == producer * requests + i;
+}
+
+int main(int argc, char **argv)
+{
+    int producers = argc > 1 ? std::atoi(argv[1]) : 8;
+    int requests = argc > 2 ? std::atoi(argv[2]) : 100000;
+    int rounds = argc > 3 ? std::atoi(argv[3]) : 5;
+    bool failed = false;
+    double seconds = 0;
+
+    vector<IntakeRequest> batch;
+    for (int round = 0; round < rounds && !failed; round++)
+    {
+        IntakeQueue queue;
+        std::atomic<bool> go(false);
+        vector<std::thread> threads = startProducers(queue, producers, requests, go);
+        auto start = std::chrono::steady_clock::now();
+        go.store(true, std::memory_order_release);
+        for (std::thread &thread : threads)
+        {
+            thread.join();
+        }
+        seconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        queue.drain(batch);
+        if (batch.size() != static_cast<size_t>(producers) * requests)
+        {
+            std::printf("round %d: drained %zu requests, expected %d\n", round, batch.size(), producers * requests);
+            failed = true;
+        }
+        for (size_t j = 0; j < batch.size() && !failed; j++)
+        {
+            if (!expected(batch[j], static_cast<int>(j / requests), static_cast<int>(j % requests), requests))
+            {
+                std::printf("round %d: request %zu out of order\n", round, j);
+                failed = true;
+            }
+        }
+    }
+    if (!failed)
+    {
+        double pushes = static_cast<double>(producers) * requests * rounds;
+        std::printf("%d producers, %d rounds: one batch per round in the same order every round, %.1f ns per push\n",
+                    producers, rounds, seconds * 1e9 / pushes);
+    }
+
+    // Draining while the producers run splits their requests over many batches
+    {
+        IntakeQueue queue;
+        std::atomic<bool> go(false);
+        vector<std::thread> threads = startProducers(queue, producers, requests, go);
+        vector<int> next(producers, 0);
+        size_t drained = 0;
+        int batches = 0;
+        go.store(true, std::memory_order_release);
+        while (drained < static_cast<size_t>(producers) * requests && !failed)
+        {
+            std::this_thread::sleep_for(std::chrono::microseconds(200));
+            if (queue.drain(batch) == 0)
+                continue;
+            batches++;
+            drained += batch.size();
+            for (const IntakeRequest &request : batch)
+            {
+                if (!expected(request, request.producerId, next[request.producerId]++, requests))
+                {
+                    std::printf("producer %d: request %d out of order\n", request.producerId, next[request.producerId] - 1);
+                    failed = true;
+                    break;
+                }
+            }
+        }
+        for (std::thread &thread : threads)
+        {
+            thread.join();
+        }
+        if (!failed)
+            std::printf("%d batches while submitting: every producer's requests in its own order\n", batches);
+    }
+    return failed ? 1 : 0;
+}
@@ -0,0 +1,131 @@
+// Memory-per-order benchmark: the old heap-per-order layout against OrderTable
+// for live orders and OrderArchive for completed ones.
+// usage: order_memory [numOrders]
+
+#include "../include/Order.h"
+#include "../include/OrderArchive.h"
+#include "../include/OrderTable.h"
+
+#include <malloc.h>
+#include <cstdio>
+#include <cstdlib>
+
+// Field layout of Order before it was packed
+struct LegacyOrder
+{
+    int id;
+    int customerId;
+    int distance;
+    int status;
+    int collectorId;
+    int driverId;
+};
+
+// Large blocks are mmapped by malloc and only show up in hblkhd
+static size_t heapInUse()
+{
+    struct mallinfo2 info = mallinfo2();
+    return info.uordblks + info.hblkhd;
+}
+
+static void report(const char *name, size_t bytes, int numOrders)
+{
+    std::printf("%-28s %12zu bytes %8.2f bytes/order\n", name, bytes, static_cast<double>(bytes) / numOrders);
+}
+
+int main(int argc, char **argv)
+{
+    int numOrders = argc > 1 ? std::atoi(argv[1]) : 1000000;
+
+    size_t before = heapInUse();
+    size_t heapBytes = 0;
+    size_t tableBytes = 0;
+    {
+        vector<LegacyOrder *> legacy;
+        for (int i = 0; i < numOrders; i++)
+        {
+            legacy.push_back(new LegacyOrder{i, i % 100, 1 + i % 20, 0, i % 50, i % 30});
+        }
+        heapBytes = heapInUse() - before;
+        report("heap Order + vector<Order*>", heapBytes, numOrders);
+        for (LegacyOrder *order : legacy)
+        {
+            delete order;
+        }
+    }
+
+    before = heapInUse();
+    {
+        OrderTable table;
+        for (int i = 0; i < numOrders; i++)
+        {
+            table.add(Order(i, i % 100, 1 + i % 20));
+        }
+        tableBytes = heapInUse() - before;
+        report("OrderTable", tableBytes, numOrders);
+    }
+
+    before = heapInUse();
+    {
+        OrderTable table;
+        vector<Order *> queue;
+        for (int i = 0; i < numOrders; i++)
+        {
+            queue.push_back(&table.add(Order(i, i % 100, 1 + i % 20)));
+        }
+        report("OrderTable + vector<Order*>", heapInUse() - before, numOrders);
+    }
+
+    // Orders complete a few ticks after they are placed, except order 0, which never does
+    before = heapInUse();
+    {
+        OrderTable table;
+        table.add(Order(0, 0, 1));
+        for (int i = 1; i < numOrders; i++)
+        {
+            table.add(Order(i, i % 100, 1 + i % 20));
+            if (i > 100)
+                table.retire(i - 100);
+        }
+        report("OrderTable, order 0 stuck", heapInUse() - before, numOrders);
+    }
+
+    before = heapInUse();
+    {
+        OrderArchive archive;
+        for (int i = 0; i < numOrders; i++)
+        {
+            Order order(i, i % 100, 1 + i % 20);
+            order.setCollectorId(i % 50);
+            order.setDriverId(i % 30);
+            archive.append(order, i / 4);
+        }
+        size_t bytes = heapInUse() - before;
+        report("OrderArchive (completed)", bytes, numOrders);
+        std::printf("  %.1fx smaller than heap orders, %.1fx smaller than OrderTable\n",
+                    static_cast<double>(heapBytes) / bytes, static_cast<double>(tableBytes) / bytes);
+    }
+
+    // Fields spread over wide ranges and orders completing out of id order widen every column
+    before = heapInUse();
+    {
+        OrderArchive archive;
+        unsigned int seed = 12345;
+        for (int i = 0; i < numOrders; i++)
+        {
+            seed = seed * 1103515245 + 12345;
+            int id = (i / 16) % 3 == 0 ? (i / 16) * 16 + 15 - i % 16 : i; // Every third run of 16 completes in reverse
+            Order order(id, static_cast<int>(seed >> 8) % 100000, 1 + static_cast<int>(seed >> 12) % 1000);
+            order.setCollectorId(static_cast<int>(seed >> 16) % 500);
+            order.setDriverId(static_cast<int>(seed >> 20) % 300);
+            archive.append(order, i / 4);
+        }
+        size_t bytes = heapInUse() - before;
+        report("OrderArchive, scattered", bytes, numOrders);
+        std::printf("  %.1fx smaller than heap orders, %.1fx smaller than OrderTable\n",
+                    static_cast<double>(heapBytes) / bytes, static_cast<double>(tableBytes) / bytes);
+    }
+
+    std::printf("sizeof(LegacyOrder) = %zu, sizeof(Order) = %zu\n", sizeof(LegacyOrder), sizeof(Order));
+    return 0;
+}
@@ -0,0 +1,374 @@
+// Differential replay: runs the original engine (bench/reference, the baseline sources
+// in namespace reference) and the optimized WareHouse on the same generated
+// configuration and command stream, compares their state after every simulation step
+// and reports the throughput of both.
+// usage: replay [seed] [steps] [customers] [volunteers]
+
+#include "reference/include/Action.h"
+#include "reference/include/Volunteer.h"
+#include "../include/Action.h"
+#include "../include/WareHouse.h"
+#include "../include/Volunteer.h"
+#include "../include/OutputSink.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <unistd.h>
+
+WareHouse *backup = nullptr;
+namespace reference
+{
+    WareHouse *backup = nullptr;
+}
+
+// Names the first field that differs, so a failure points at the broken invariant
+class Comparison
+{
+public:
+    Comparison() : where(), difference() {}
+
+    void check(const string &field, long long expected, long long actual)
+    {
+        if (difference.empty() && expected != actual)
+        {
+            difference = where + field + ": reference " + std::to_string(expected) + ", optimized " + std::to_string(actual);
+        }
+    }
+    void at(const string &place)
+    {
+        where = place;
+    }
+    bool same() const
+    {
+        return difference.empty();
+    }
+    const string &getDifference() const
+    {
+        return difference;
+    }
+
+private:
+    string where;
+    string difference;
+};
+
+static void compareQueue(Comparison &comparison, const char *name, const vector<reference::Order *> &expected, const vector<Order *> &actual)
+{
+    comparison.at(name);
+    comparison.check(" size", expected.size(), actual.size());
+    for (size_t i = 0; i < expected.size() && i < actual.size() && comparison.same(); i++)
+    {
+        comparison.at(string(name) + "[" + std::to_string(i) + "].");
+        comparison.check("id", expected[i]->getId(), actual[i]->getId());
+        comparison.check("status", static_cast<int>(expected[i]->getStatus()), static_cast<int>(actual[i]->getStatus()));
+        comparison.check("customerId", expected[i]->getCustomerId(), actual[i]->getCustomerId());
+        comparison.check("distance", expected[i]->getDistance(), actual[i]->getDistance());
+        comparison.check("collectorId", expected[i]->getCollectorId(), actual[i]->getCollectorId());
+        comparison.check("driverId", expected[i]->getDriverId(), actual[i]->getDriverId());
+    }
+}
+
+// The original engine has no volunteer list getter, volunteers are found by id
+static reference::Volunteer *findVolunteer(const reference::WareHouse &wareHouse, int volunteerId)
+{
+    try
+    {
+        return &wareHouse.getVolunteer(volunteerId);
+    }
+    catch (const std::runtime_error &)
+    {
+        return nullptr;
+    }
+}
+
+static VolunteerRecord referenceRecord(reference::Volunteer *volunteer)
+{
+    VolunteerRecord record = {volunteer->getId(), volunteer->getActiveOrderId(), 0, NO_LIMIT};
+    if (auto *collector = dynamic_cast<reference::CollectorVolunteer *>(volunteer))
+        record.timeLeft = collector->getTimeLeft();
+    else
+        record.timeLeft = dynamic_cast<reference::DriverVolunteer *>(volunteer)->getDistanceLeft();
+    if (auto *limitedCollector = dynamic_cast<reference::LimitedCollectorVolunteer *>(volunteer))
+        record.ordersLeft = limitedCollector->getNumOrdersLeft();
+    else if (auto *limitedDriver = dynamic_cast<reference::LimitedDriverVolunteer *>(volunteer))
+        record.ordersLeft = limitedDriver->getNumOrdersLeft();
+    return record;
+}
+
+static int countVolunteers(const reference::WareHouse &wareHouse)
+{
+    int count = 0;
+    for (int id = 0; id < wareHouse.getVolunteerCounter(); id++)
+    {
+        count += findVolunteer(wareHouse, id) != nullptr;
+    }
+    return count;
+}
+
+// The original engine looks volunteers up by index; once deletions shrink the list
+// below an assigned id it reads past the end, and so would the optimized one
+static bool indexesPastVolunteers(const reference::WareHouse &wareHouse)
+{
+    int count = countVolunteers(wareHouse);
+    for (const reference::Order *order : wareHouse.getInProcessOrders())
+    {
+        if (order->getCollectorId() >= count || order->getDriverId() >= count)
+            return true;
+    }
+    return false;
+}
+
+static string compare(const reference::WareHouse &expected, const WareHouse &actual)
+{
+    Comparison comparison;
+    compareQueue(comparison, "pending", expected.getPendingOrders(), actual.getPendingOrders());
+    compareQueue(comparison, "inProcess", expected.getInProcessOrders(), actual.getInProcessOrders());
+
+    const vector<reference::Order *> &completed = expected.getCompletedOrders();
+    comparison.at("completed");
+    comparison.check(" size", completed.size(), actual.getCompletedOrders().size());
+    OrderArchive::Cursor cursor(actual.getCompletedOrders());
+    ArchivedOrder archived;
+    for (size_t i = 0; i < completed.size() && comparison.same() && cursor.next(archived); i++)
+    {
+        comparison.at("completed[" + std::to_string(i) + "].");
+        comparison.check("id", completed[i]->getId(), archived.id);
+        comparison.check("customerId", completed[i]->getCustomerId(), archived.customerId);
+        comparison.check("distance", completed[i]->getDistance(), archived.distance);
+        comparison.check("collectorId", completed[i]->getCollectorId(), archived.collectorId);
+        comparison.check("driverId", completed[i]->getDriverId(), archived.driverId);
+    }
+
+    const VolunteerList &volunteers = actual.getVolunteers();
+    comparison.at("volunteers");
+    comparison.check(" size", countVolunteers(expected), volunteers.size());
+    for (size_t i = 0; i < volunteers.size() && comparison.same(); i++)
+    {
+        reference::Volunteer *volunteer = findVolunteer(expected, volunteers[i]->getId());
+        comparison.at("volunteers[" + std::to_string(i) + "].");
+        comparison.check("exists", true, volunteer != nullptr);
+        if (volunteer == nullptr)
+            break;
+        VolunteerRecord expectedRecord = referenceRecord(volunteer);
+        VolunteerRecord actualRecord = actual.getVolunteerRecord(volunteers[i]);
+        comparison.check("activeOrderId", expectedRecord.activeOrderId, actualRecord.activeOrderId);
+        comparison.check("completedOrderId", volunteer->getCompletedOrderId(), volunteers[i]->getCompletedOrderId());
+        comparison.check("timeLeft", expectedRecord.timeLeft, actualRecord.timeLeft);
+        comparison.check("ordersLeft", expectedRecord.ordersLeft, actualRecord.ordersLeft);
+    }
+
+    const vector<reference::Customer *> &customers = expected.getCustomers();
+    comparison.at("customers");
+    comparison.check(" size", customers.size(), actual.getCustomers().size());
+    for (size_t i = 0; i < customers.size() && i < actual.getCustomers().size() && comparison.same(); i++)
+    {
+        const vector<int> &expectedOrders = customers[i]->getOrdersIds();
+        const vector<int> &orders = actual.getCustomers()[i]->getOrdersIds();
+        comparison.at("customers[" + std::to_string(i) + "].");
+        comparison.check("orders", expectedOrders.size(), orders.size());
+        for (size_t j = 0; j < orders.size() && j < expectedOrders.size(); j++)
+        {
+            comparison.check("orders[" + std::to_string(j) + "]", expectedOrders[j], orders[j]);
+        }
+    }
+
+    // The summary is kept up to date change by change, count the reference state instead
+    int statuses[4] = {0, 0, 0, static_cast<int>(completed.size())};
+    for (const vector<reference::Order *> *queue : {&expected.getPendingOrders(), &expected.getInProcessOrders()})
+    {
+        for (const reference::Order *order : *queue)
+            statuses[static_cast<int>(order->getStatus())]++;
+    }
+    int busyVolunteers = 0;
+    for (int id = 0; id < expected.getVolunteerCounter(); id++)
+    {
+        reference::Volunteer *volunteer = findVolunteer(expected, id);
+        busyVolunteers += volunteer != nullptr && volunteer->isBusy();
+    }
+    int customersAtLimit = 0;
+    for (const reference::Customer *customer : customers)
+    {
+        customersAtLimit += !customer->canMakeOrder();
+    }
+    const WareHouseSummary &summary = actual.getSummary();
+    comparison.at("summary.");
+    comparison.check("pendingOrders", statuses[0], summary.pendingOrders);
+    comparison.check("collectingOrders", statuses[1], summary.collectingOrders);
+    comparison.check("deliveringOrders", statuses[2], summary.deliveringOrders);
+    comparison.check("completedOrders", statuses[3], summary.completedOrders);
+    comparison.check("busyVolunteers", busyVolunteers, summary.busyVolunteers);
+    comparison.check("customersAtLimit", customersAtLimit, summary.customersAtLimit);
+    return comparison.getDifference();
+}
+
+// Collectors and drivers first so the volunteer list usually outlives the limited ones
+static string generateConfig(std::mt19937 &random, int numCustomers, int numVolunteers)
+{
+    string config;
+    for (int i = 0; i < numCustomers; i++)
+    {
+        config += "customer c" + std::to_string(i) + (random() % 2 ? " soldier " : " civilian ") +
+                  std::to_string(1 + random() % 30) + " " + std::to_string(1 + random() % 40) + "\n";
+    }
+    for (int i = 0; i < numVolunteers; i++)
+    {
+        string name = " v" + std::to_string(i);
+        switch (i < numVolunteers / 2 ? i % 2 : 2 + random() % 4)
+        {
+        case 0:
+        case 2:
+            config += "volunteer" + name + " collector " + std::to_string(1 + random() % 5) + "\n";
+            break;
+        case 1:
+        case 3:
+            config += "volunteer" + name + " driver " + std::to_string(10 + random() % 25) + " " + std::to_string(1 + random() % 6) + "\n";
+            break;
+        case 4:
+            config += "volunteer" + name + " limited_collector " + std::to_string(1 + random() % 5) + " " + std::to_string(20 + random() % 200) + "\n";
+            break;
+        default:
+            config += "volunteer" + name + " limited_driver " + std::to_string(10 + random() % 25) + " " + std::to_string(1 + random() % 6) + " " + std::to_string(20 + random() % 200) + "\n";
+            break;
+        }
+    }
+    return config;
+}
+
+// Commands placed before one simulation step, in the command line syntax
+static void generateCommands(std::mt19937 &random, int numCustomers, vector<string> &commands)
+{
+    commands.clear();
+    int orders = random() % 5;
+    for (int i = 0; i < orders; i++)
+    {
+        commands.push_back("order " + std::to_string(random() % (numCustomers + 2))); // Sometimes an unknown customer
+    }
+    int roll = random() % 200;
+    if (roll == 0)
+        commands.push_back("backup");
+    else if (roll == 1)
+        commands.push_back("restore");
+    else if (roll < 5)
+        commands.push_back("customer new" + std::to_string(random() % 1000) + " civilian " + std::to_string(1 + random() % 30) + " " + std::to_string(1 + random() % 40));
+    commands.push_back("step 1");
+}
+
+// The actions the original WareHouse::start() created for these command lines
+static void executeReference(reference::WareHouse &wareHouse, const string &command)
+{
+    if (command == "backup")
+    {
+        reference::BackupWareHouse action;
+        action.act(wareHouse);
+    }
+    else if (command == "restore")
+    {
+        reference::RestoreWareHouse action;
+        action.act(wareHouse);
+    }
+    else if (command.substr(0, 4) == "step")
+    {
+        reference::SimulateStep action(std::stoi(command.substr(5)));
+        action.act(wareHouse);
+    }
+    else if (command.substr(0, 5) == "order")
+    {
+        reference::AddOrder action(std::stoi(command.substr(6)));
+        action.act(wareHouse);
+    }
+    else
+    {
+        std::istringstream iss(command.substr(9));
+        string name, typeString;
+        int distance, maxOrders;
+        iss >> name >> typeString >> distance >> maxOrders;
+        reference::AddCustomer action(name, typeString, distance, maxOrders);
+        action.act(wareHouse);
+    }
+}
+
+int main(int argc, char **argv)
+{
+    unsigned seed = argc > 1 ? std::atoi(argv[1]) : 1;
+    int steps = argc > 2 ? std::atoi(argv[2]) : 20000;
+    int numCustomers = argc > 3 ? std::atoi(argv[3]) : 200;
+    int numVolunteers = argc > 4 ? std::atoi(argv[4]) : 40;
+
+    std::mt19937 random(seed);
+    char configPath[] = "/tmp/replay_configXXXXXX";
+    int fd = ::mkstemp(configPath);
+    string config = generateConfig(random, numCustomers, numVolunteers);
+    if (fd < 0 || ::write(fd, config.data(), config.size()) != static_cast<ssize_t>(config.size()))
+    {
+        throw std::runtime_error("Could not write the generated configuration");
+    }
+    ::close(fd);
+    reference::WareHouse expected(configPath);
+    WareHouse actual(configPath);
+    ::unlink(configPath);
+    expected.open();
+    actual.open();
+
+    // What either engine prints is not part of the comparison
+    string discarded;
+    output.beginCapture(discarded);
+    std::ostringstream referenceOutput;
+    std::streambuf *console = std::cout.rdbuf(referenceOutput.rdbuf());
+
+    std::chrono::steady_clock::duration referenceTime(0);
+    std::chrono::steady_clock::duration optimizedTime(0);
+    vector<string> commands;
+    int step = 0;
+    string difference;
+    for (; step < steps && difference.empty(); step++)
+    {
+        if (indexesPastVolunteers(expected))
+        {
+            std::printf("stopped before step %d: an order refers to a deleted volunteer past the end of the list\n", step);
+            break;
+        }
+        generateCommands(random, static_cast<int>(expected.getCustomers().size()), commands);
+
+        std::chrono::steady_clock::time_point begin = std::chrono::steady_clock::now();
+        for (const string &command : commands)
+        {
+            executeReference(expected, command);
+        }
+        std::chrono::steady_clock::time_point middle = std::chrono::steady_clock::now();
+        for (const string &command : commands)
+        {
+            actual.execute(command);
+        }
+        std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+        referenceTime += middle - begin;
+        optimizedTime += end - middle;
+
+        discarded.clear();
+        referenceOutput.str(string());
+        difference = compare(expected, actual);
+    }
+    std::cout.rdbuf(console);
+    output.endCapture();
+
+    if (!difference.empty())
+    {
+        std::printf("MISMATCH after step %d: %s\n", step, difference.c_str());
+        return 1;
+    }
+    size_t completed = expected.getCompletedOrders().size();
+    double referenceSeconds = std::chrono::duration<double>(referenceTime).count();
+    double optimizedSeconds = std::chrono::duration<double>(optimizedTime).count();
+    std::printf("%d steps, %zu orders completed: states identical after every step\n", step, completed);
+    std::printf("%-10s %12s %14s\n", "engine", "steps/s", "completions/s");
+    std::printf("%-10s %12.0f %14.0f\n", "original", step / referenceSeconds, completed / referenceSeconds);
+    std::printf("%-10s %12.0f %14.0f\n", "optimized", step / optimizedSeconds, completed / optimizedSeconds);
+    std::printf("speedup    %11.2fx\n", referenceSeconds / optimizedSeconds);
+    delete backup;
+    delete reference::backup;
+    return 0;
+}
@@ -2,46 +2,42 @@
 #include <string>
 #include <iostream>
 #include <ostream>
+#include <string_view>
 #include <vector>
 #include "WareHouse.h"
+#include "ActionLog.h"
 using std::string;
 using std::vector;
 
 extern WareHouse *backup;
 
-enum class ActionStatus
-{
-    COMPLETED,
-    ERROR
-};
-
-enum class CustomerType
-{
-    Soldier,
-    Civilian
-};
-
 class BaseAction
 {
 public:
     BaseAction();
     ActionStatus getStatus() const;
     virtual void act(WareHouse &wareHouse) = 0;
-    virtual string toString() const = 0;
+    virtual ActionRecord toRecord() const = 0; // What the action log keeps of this action
+    virtual std::string_view getRecordText() const; // The text argument logged beside the record, if any
+    void appendTo(string &buffer) const;       // Append the command text to buffer
+    string toString() const;
     virtual BaseAction *clone() const = 0;
 
     virtual ~BaseAction() = default;
-    const string getStatusString(enum ActionStatus sta) const;
-    const string getCustomerTypeString(enum CustomerType ct) const;
+    static std::string_view getStatusString(enum ActionStatus sta);
+    static std::string_view getCustomerTypeString(enum CustomerType ct);
     void print() const;
+    void print(string &buffer) const; // Formats the log line in buffer, reusing its capacity
+    void appendLogLine(string &buffer) const; // Append "<command> <status>\n" to buffer
 
 protected:
     void complete();
-    void error(string errorMsg);
+    void error(ActionError errorCode);
     string getErrorMsg() const;
+    ActionRecord makeRecord(ActionKind kind, int32_t arg0 = 0, int32_t arg1 = 0, int32_t arg2 = 0, int32_t arg3 = 0) const;
 
 private:
-    string errorMsg;
+    ActionError errorCode;
     ActionStatus status;
 };
 
@@ -50,7 +46,7 @@ class SimulateStep : public BaseAction {
     public:
         SimulateStep(int numOfSteps);
         void act(WareHouse &wareHouse) override;
-        std::string toString() const override;
+        ActionRecord toRecord() const override;
         SimulateStep *clone() const override;
 
     private:
@@ -62,7 +58,7 @@ class AddOrder : public BaseAction
 public:
     AddOrder(int id);
     void act(WareHouse &wareHouse) override;
-    string toString() const override;
+    ActionRecord toRecord() const override;
     AddOrder *clone() const override;
 
 private:
@@ -75,12 +71,12 @@ public:
     AddCustomer(const string &customerName, const string &customerType, int distance, int maxOrders);
     void act(WareHouse &wareHouse) override;
     AddCustomer *clone() const override;
-    string toString() const override;
+    ActionRecord toRecord() const override;
 
     int customerTypeStringToInt(const string &customerType);
 
 private:
-    const string customerName;
+    const NameId customerName; // Interned in NameTable
     const CustomerType customerType;
     const int distance;
     const int maxOrders;
@@ -92,7 +88,7 @@ public:
     PrintOrderStatus(int id);
     void act(WareHouse &wareHouse) override;
     PrintOrderStatus *clone() const override;
-    string toString() const override;
+    ActionRecord toRecord() const override;
 
 private:
     const int orderId;
@@ -104,7 +100,7 @@ public:
     PrintCustomerStatus(int customerId);
     void act(WareHouse &wareHouse) override;
     PrintCustomerStatus *clone() const override;
-    string toString() const override;
+    ActionRecord toRecord() const override;
 
 private:
     const int customerId;
@@ -116,7 +112,7 @@ public:
     PrintVolunteerStatus(int id);
     void act(WareHouse &wareHouse) override;
     PrintVolunteerStatus *clone() const override;
-    string toString() const override;
+    ActionRecord toRecord() const override;
 
 private:
     const int volunteerId;
@@ -128,7 +124,7 @@ public:
     PrintActionsLog();
     void act(WareHouse &wareHouse) override;
     PrintActionsLog *clone() const override;
-    string toString() const override;
+    ActionRecord toRecord() const override;
 
 private:
 };
@@ -139,9 +135,10 @@ public:
     Close();
     void act(WareHouse &wareHouse) override;
     Close *clone() const override;
-    string toString() const override;
+    ActionRecord toRecord() const override;
 
     void printOrders(const vector<Order *> &orders) const;
+    void printOrders(const OrderArchive &orders) const;
 
 private:
 };
@@ -152,7 +149,7 @@ public:
     BackupWareHouse();
     void act(WareHouse &wareHouse) override;
     BackupWareHouse *clone() const override;
-    string toString() const override;
+    ActionRecord toRecord() const override;
 
 private:
 };
@@ -163,7 +160,68 @@ public:
     RestoreWareHouse();
     void act(WareHouse &wareHouse) override;
     RestoreWareHouse *clone() const override;
-    string toString() const override;
+    ActionRecord toRecord() const override;
+
+private:
+};
+
+class SaveCheckpoint : public BaseAction
+{
+public:
+    SaveCheckpoint(const string &name);
+    void act(WareHouse &wareHouse) override;
+    SaveCheckpoint *clone() const override;
+    ActionRecord toRecord() const override;
+    std::string_view getRecordText() const override;
+
+private:
+    const string name;
+};
+
+class RestoreCheckpoint : public BaseAction
+{
+public:
+    RestoreCheckpoint(const string &name);
+    void act(WareHouse &wareHouse) override;
+    RestoreCheckpoint *clone() const override;
+    ActionRecord toRecord() const override;
+    std::string_view getRecordText() const override;
+
+private:
+    const string name;
+};
+
+class PrintCheckpoints : public BaseAction
+{
+public:
+    PrintCheckpoints();
+    void act(WareHouse &wareHouse) override;
+    PrintCheckpoints *clone() const override;
+    ActionRecord toRecord() const override;
+
+private:
+};
+
+class SaveSnapshot : public BaseAction
+{
+public:
+    SaveSnapshot(const string &path);
+    void act(WareHouse &wareHouse) override;
+    SaveSnapshot *clone() const override;
+    ActionRecord toRecord() const override;
+    std::string_view getRecordText() const override;
+
+private:
+    const string path;
+};
+
+class PrintSaveStatus : public BaseAction
+{
+public:
+    PrintSaveStatus();
+    void act(WareHouse &wareHouse) override;
+    PrintSaveStatus *clone() const override;
+    ActionRecord toRecord() const override;
 
 private:
 };
@@ -0,0 +1,98 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "NameTable.h"
+using std::string;
+using std::vector;
+
+enum class ActionStatus : uint8_t
+{
+    COMPLETED,
+    ERROR
+};
+
+enum class CustomerType
+{
+    Soldier,
+    Civilian
+};
+
+enum class ActionKind : uint8_t
+{
+    STEP,
+    ORDER,
+    CUSTOMER,
+    ORDER_STATUS,
+    CUSTOMER_STATUS,
+    VOLUNTEER_STATUS,
+    LOG,
+    CLOSE,
+    BACKUP,
+    RESTORE,
+    SAVE_CHECKPOINT,
+    RESTORE_CHECKPOINT,
+    CHECKPOINTS,
+    SAVE,
+    SAVE_STATUS
+};
+
+// Why an action failed; getActionErrorText has the message of each
+enum class ActionError : uint8_t
+{
+    NONE,
+    NO_BACKUP,
+    CHECKPOINT_EXISTS,
+    CHECKPOINT_MISSING,
+    SAVE_RUNNING,
+    SAVE_NOT_STARTED,
+    CANNOT_PLACE_ORDER,
+    ORDER_MISSING,
+    CUSTOMER_MISSING,
+    VOLUNTEER_MISSING
+};
+
+std::string_view getActionErrorText(ActionError error);
+ActionError findActionError(std::string_view text); // NONE if no error has this message
+
+#define ACTION_RECORD_ARGS 4
+
+// One logged action: which command ran, its arguments and how it ended. Customer
+// names are NameTable ids; checkpoint names and paths are kept in the text of the
+// log that holds the record (args[0] is the offset, args[1] the length). Every record
+// has the same size and owns no memory.
+struct ActionRecord
+{
+    ActionKind kind;
+    ActionStatus status;
+    ActionError error; // NONE unless the action failed
+    int32_t args[ACTION_RECORD_ARGS];
+};
+
+// The action log of a WareHouse, as records in one contiguous vector and the text
+// arguments of the records in one string. Logging an action appends 20 bytes instead
+// of heap-cloning the action object, and copying the log for a backup is a copy of the
+// vector and the string. The command text is formatted from the record only when the
+// log is printed.
+class ActionLog
+{
+public:
+    ActionLog();
+    void append(const ActionRecord &record, std::string_view text = std::string_view()); // text for kinds that take one
+    void append(const ActionLog &other, size_t index); // Copy a record of another log with its text
+    void replaceLast(const ActionRecord &record);      // Same kind as the last record; its text is kept
+    void clear();
+    size_t size() const;
+    const ActionRecord &operator[](size_t index) const;
+    std::string_view getText(size_t index) const; // Empty for kinds without a text argument
+    size_t memoryUsage() const; // Bytes held by the records and their text
+
+    void appendLine(size_t index, string &buffer) const; // Append "<command> <status>\n" to buffer
+    static void appendCommand(const ActionRecord &record, std::string_view text, string &buffer); // Append the command text to buffer
+    static bool hasText(ActionKind kind);
+
+private:
+    vector<ActionRecord> records;
+    string text;
+};
@@ -0,0 +1,58 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <sys/types.h>
+using std::string;
+
+class WareHouse;
+
+#define SAVE_BUFFER_SIZE (256 * 1024) // The child writes the snapshot in chunks this big
+
+// Writes a snapshot of a WareHouse to disk without stopping the command loop.
+// start() forks at a command boundary: the child gets a copy-on-write image of the
+// warehouse as it is at that moment, serializes it and exits, while the parent goes on
+// running commands and steps. The child writes <path>.tmp and renames it over <path>
+// once complete, so the file at <path> is always a whole snapshot. Progress is shared
+// through an anonymous shared mapping; the parent reaps the child when asked for status.
+class BackgroundSave
+{
+public:
+    BackgroundSave();
+    ~BackgroundSave(); // Waits for a running save, so it is never cut short
+    BackgroundSave(const BackgroundSave &other) = delete;
+    BackgroundSave &operator=(const BackgroundSave &other) = delete;
+
+    bool start(const string &path, const WareHouse &wareHouse); // False if it could not fork
+    bool isRunning();                                           // Reaps a finished child first
+    void appendStatus(string &buffer);                          // One line, reaps a finished child first
+
+private:
+    enum class State
+    {
+        IDLE,
+        RUNNING,
+        DONE,
+        FAILED
+    };
+
+    // Written by the child, read by the parent
+    struct Progress
+    {
+        std::atomic<long long> rows;
+        std::atomic<long long> bytes;
+        std::atomic<int> error; // errno of the failed call, 0 if none
+        std::atomic<long long> finishedAt; // steady_clock ticks; the clock is shared between processes
+    };
+
+    void poll(bool wait); // Reap the child if it exited
+    static int write(const WareHouse &wareHouse, const string &path, Progress &progress); // Child side, returns errno or 0
+
+    Progress *progress; // Shared with the child
+    pid_t child;
+    State state;
+    string path;
+    long long totalRows;
+    int tick; // Simulation tick the snapshot was taken at
+    std::chrono::steady_clock::time_point started;
+};
@@ -0,0 +1,101 @@
+#pragma once
+#include <string>
+#include <vector>
+#include "Order.h"
+#include "OrderArchive.h"
+#include "ActionLog.h"
+#include "VolunteerList.h"
+using std::string;
+using std::vector;
+
+class WareHouse;
+class Customer;
+
+#define NO_PARENT -1
+
+// How an order queue or the volunteer list changed: entries only ever leave from
+// anywhere and join at the back, so the survivors keep their relative order
+struct ListDelta
+{
+    ListDelta() : removed(), appended() {}
+    vector<int> removed; // Sorted ids
+    vector<int> appended;
+};
+
+// One named checkpoint, stored as what changed since its parent. The first checkpoint
+// (and the first one after the state was replaced by something else) is a delta
+// against an empty warehouse.
+struct Checkpoint
+{
+    Checkpoint(const string &name, int parent);
+    ~Checkpoint();
+    Checkpoint(const Checkpoint &other) = delete;
+    Checkpoint &operator=(const Checkpoint &other) = delete;
+    size_t deltaBytes() const; // Approximate, sealed archive blocks are shared and not counted
+
+    string name;
+    int parent; // Index in the store, NO_PARENT for a delta against an empty warehouse
+    int customerCounter;
+    int volunteerCounter;
+    int orderCounter;
+    int currentTick;
+
+    vector<Order> changedOrders; // Live orders added or changed, by increasing id
+    vector<int> retiredOrders;   // Live in the parent, completed since
+    ListDelta pendingOrders;
+    ListDelta inProcessOrders;
+    OrderArchive completedOrders; // Shares its sealed blocks with the other checkpoints
+
+    VolunteerList newVolunteers;
+    ListDelta volunteers;
+    vector<std::pair<int, VolunteerTimers>> changedTimers; // By volunteer id
+
+    vector<Customer *> newCustomers;                   // Owned
+    vector<std::pair<size_t, int>> newCustomerOrders; // Customer index, order id
+    ActionLog newActions;
+};
+
+// Named checkpoints of one WareHouse.
+// The store remembers the state of the checkpoint last saved or restored (the head) in
+// a compact image, and a new checkpoint only records its difference to the head. As
+// long as the warehouse only moved forward since then, dozens of checkpoints cost
+// little more than the first one. Restoring replays the deltas from the oldest
+// ancestor down to the checkpoint.
+class CheckpointStore
+{
+public:
+    CheckpointStore();
+    ~CheckpointStore();
+    CheckpointStore(const CheckpointStore &other) = delete;
+    CheckpointStore &operator=(const CheckpointStore &other) = delete;
+
+    bool save(const string &name, const WareHouse &wareHouse); // False if the name is taken
+    bool contains(const string &name) const;
+    bool restore(const string &name, WareHouse &wareHouse);    // False if there is no such checkpoint
+    void appendList(string &buffer) const;                      // One line per checkpoint
+
+private:
+    // The head checkpoint's state, flattened
+    struct Image
+    {
+        Image();
+        vector<Order> orders; // Live orders by increasing id
+        vector<int> pendingOrders;
+        vector<int> inProcessOrders;
+        vector<int> volunteers;
+        vector<VolunteerTimers> timers; // Indexed by volunteer id
+        int volunteerCounter;
+        vector<size_t> customerOrders; // Number of orders per customer
+        size_t actions;
+    };
+
+    int find(const string &name) const;
+    void capture(const WareHouse &wareHouse); // Make the image match the warehouse
+    static ListDelta diff(const vector<int> &before, const vector<int> &after);
+    static void apply(const ListDelta &delta, vector<int> &list);
+
+    vector<Checkpoint *> checkpoints;
+    int head;
+    int headRestoreCount; // The warehouse's restore count when head was current
+    Image image;
+};
@@ -1,6 +1,7 @@
 #pragma once
 #include <string>
 #include <vector>
+#include "NameTable.h"
 using std::string;
 using std::vector;
 
@@ -10,6 +11,7 @@ class Customer {
     public:
         Customer(int id, const string &name, int locationDistance, int maxOrders);
         const string &getName() const;
+        NameId getNameId() const;
         int getId() const;
         int getCustomerDistance() const;
         int getMaxOrders() const; //Returns maxOrders
@@ -17,14 +19,16 @@ class Customer {
         bool canMakeOrder() const; //Returns true if the customer didn't reach max orders
         const vector<int> &getOrdersIds() const;
         int addOrder(int orderId); //return OrderId if order was added successfully, -1 otherwise
+        void setOrdersIds(const vector<int> &ordersIds); // Overwrite the orders, reusing their storage
 
         virtual Customer *clone() const = 0; // Return a copy of the customer
-        virtual string toString() const;
+        string toString() const;
+        virtual void appendTo(string &buffer) const; // Append toString() to buffer
         
         virtual ~Customer() = default;
     private:
         const int id;
-        const string name;
+        const NameId name; // Interned in NameTable
         const int locationDistance;
         const int maxOrders;
         vector<int> ordersId;
@@ -35,7 +39,7 @@ class SoldierCustomer: public Customer {
     public:
         SoldierCustomer(int id, const string &name, int locationDistance, int maxOrders);
         SoldierCustomer *clone() const override;
-        string toString() const override;
+        void appendTo(string &buffer) const override;
 
     private:
         
@@ -45,7 +49,7 @@ class CivilianCustomer: public Customer {
     public:
         CivilianCustomer(int id, const string &name, int locationDistance, int maxOrders);
         CivilianCustomer *clone() const override;
-        string toString() const override;
+        void appendTo(string &buffer) const override;
 
     private:
         
@@ -0,0 +1,68 @@
+#pragma once
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+using std::string;
+using std::vector;
+
+class WareHouse;
+
+#define DEMAND_DEFAULT_SEED 1
+
+enum class ArrivalModel
+{
+    POISSON, // "<type> poisson <rate>", rate orders per tick on average
+    ON_OFF   // "<type> onoff <rate> <on_ticks> <off_ticks>", Poisson at rate in bursts, nothing between
+};
+
+// One arrival process, placing orders for the customers of one type
+struct ArrivalProcess
+{
+    string name;         // As written
+    string customerType; // soldier, civilian or all
+    ArrivalModel model;
+    double rate;     // Mean orders per tick, during a burst for ON_OFF
+    double onTicks;  // ON_OFF: mean length of a burst
+    double offTicks; // ON_OFF: mean gap between bursts
+    bool on;         // ON_OFF: in a burst; processes start in one
+    long long arrived;
+    long long placed; // The rest found no customer of the type able to order
+
+    vector<int> customerIds; // Of the type, able to order when last looked at
+    int customersSeen;       // Customers looked at so far
+    int restoreCount;        // Of the warehouse when they were
+};
+
+// Places orders every tick from seeded random arrival processes, for load testing.
+// Each process draws how many orders arrive in the tick, Poisson with its rate; an on/off
+// process switches between bursts and silence, both of geometric length with the means
+// given. Every arrival goes to a customer of the type picked at random among those that
+// can still order (Customer::canMakeOrder), and is dropped when there is none. Orders are
+// placed the way AddOrder places them, but neither logged nor printed.
+// The draws come from one std::mt19937_64 stream and are turned into numbers here, not by
+// the standard distributions whose results differ between libraries, so one seed and the
+// same commands place the same orders anywhere.
+// The generator belongs to the warehouse object rather than its state: copies start
+// without any process, and a restore leaves the processes running.
+class DemandGenerator
+{
+public:
+    DemandGenerator();
+
+    void setSeed(uint64_t seed); // Restarts the random stream, bursts start over
+    void add(const string &text); // A process as in ArrivalModel, throws std::invalid_argument
+    void clear();                 // Stops every process
+    bool isActive() const;
+    void generate(WareHouse &wareHouse); // Place the orders arriving in this tick
+    void appendReport(string &buffer) const;
+
+private:
+    double uniform(); // In [0, 1)
+    long long poisson(double mean);
+    void refresh(ArrivalProcess &process, const WareHouse &wareHouse) const; // Take in new customers
+
+    std::mt19937_64 random;
+    uint64_t seed;
+    vector<ArrivalProcess> processes;
+};
@@ -0,0 +1,19 @@
+#pragma once
+#include <charconv>
+#include <string>
+#include <string_view>
+
+// Helpers for the appendTo() formatters: they write into a caller-supplied buffer,
+// so a reused buffer formats a line without any heap allocation.
+
+inline void appendText(std::string &buffer, std::string_view text)
+{
+    buffer.append(text.data(), text.size());
+}
+
+inline void appendInt(std::string &buffer, long long value)
+{
+    char digits[24];
+    std::to_chars_result result = std::to_chars(digits, digits + sizeof(digits), value);
+    buffer.append(digits, result.ptr - digits);
+}
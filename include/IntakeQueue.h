@@ -0,0 +1,79 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <vector>
+#include "NameTable.h"
+using std::vector;
+
+enum class IntakeKind : uint8_t
+{
+    ORDER,
+    CUSTOMER
+};
+
+// An order or customer request submitted by a producer thread
+struct IntakeRequest
+{
+    IntakeKind kind;
+    bool soldier;     // CUSTOMER only
+    int producerId;
+    uint64_t sequence; // Per-producer submission number
+    int customerId;    // ORDER only
+    NameId name;       // CUSTOMER only
+    int distance;      // CUSTOMER only
+    int maxOrders;     // CUSTOMER only
+};
+
+// What applying one request printed, for the producer that submitted it
+struct IntakeOutcome
+{
+    int producerId;
+    uint64_t sequence;
+    string printed;
+};
+
+// Lock-free multi-producer / single-consumer queue of intake requests.
+// Producers push onto an atomic list head with a CAS loop and never block; the
+// simulation thread takes the whole list with one exchange at a step boundary and
+// orders the batch by (producer id, sequence), so the requests are applied in the
+// same order no matter how the producer threads interleaved. That order is only
+// deterministic within one drained batch: which batch a request lands in depends on
+// when it was pushed, so across batches only each producer's own order is kept.
+class IntakeQueue
+{
+public:
+    // Submission handle for one producer thread
+    class Producer
+    {
+    public:
+        Producer(IntakeQueue &queue, int id);
+        void submitOrder(int customerId);
+        void submitCustomer(const string &name, const string &customerType, int distance, int maxOrders);
+        int getId() const;
+
+    private:
+        IntakeQueue *queue;
+        int id;
+        uint64_t nextSequence;
+    };
+
+    IntakeQueue();
+    ~IntakeQueue();
+    IntakeQueue(const IntakeQueue &other) = delete;
+    IntakeQueue &operator=(const IntakeQueue &other) = delete;
+
+    Producer makeProducer();               // Producer ids are handed out in creation order
+    void push(const IntakeRequest &request); // Safe from any thread
+    size_t drain(vector<IntakeRequest> &batch); // Consumer only, replaces batch contents
+    bool empty() const;
+
+private:
+    struct Node
+    {
+        IntakeRequest request;
+        Node *next;
+    };
+
+    std::atomic<Node *> head;
+    std::atomic<int> producerCounter;
+};
@@ -0,0 +1,33 @@
+#pragma once
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+using std::string;
+
+typedef uint32_t NameId;
+
+// Process-wide string interner for customer and volunteer names.
+// Every distinct name is stored once and referred to by a 4-byte NameId, so copying
+// a customer, a volunteer or a whole warehouse backup never copies name text.
+// Names are never released; handles stay valid for the life of the process.
+// The table stays locked across fork(), so a forked child can look names up.
+class NameTable
+{
+public:
+    static NameId intern(const string &name);
+    static const string &lookup(NameId id);
+    static size_t size(); // Number of distinct names
+
+private:
+    NameTable();
+    static NameTable &instance();
+    static void lockForFork();
+    static void unlockAfterFork();
+
+    std::mutex lock;
+    std::deque<string> names;                              // Elements never move, the index points into them
+    std::unordered_map<std::string_view, NameId> index;
+};
@@ -0,0 +1,80 @@
+#pragma once
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+using std::string;
+using std::vector;
+
+class WareHouse;
+
+#define NETWORK_VACANT_NAME "vacant"
+#define NETWORK_VACANT_REACH -1 // Max distance of a vacant slot's stand-in, short of every customer
+
+// One warehouse of the network and what went in and out of it
+struct NetworkDepot
+{
+    string configFilePath;
+    std::unique_ptr<WareHouse> wareHouse;
+    std::unique_ptr<WareHouse> backup; // Moved into the global backup while this depot's actions run
+    std::thread thread;                // Steps the warehouse, one tick at a time
+    long long routedIn;                // Orders placed here for another depot's customer
+    long long routedOut;               // Orders of this depot's customers placed elsewhere
+    long long volunteersIn;
+    long long volunteersOut;
+};
+
+// Several warehouses, one per configuration file, simulated side by side as depots.
+// Every depot has a thread that steps it; a network tick starts all of them and waits
+// for the last, so the depots never drift apart. Everything else, commands, routing and
+// rebalancing, runs on the calling thread between ticks, while no depot is stepping.
+//
+// An order is routed: the customer names the same person in every depot that knows
+// them, and the order goes to the depot expected to complete it first, judging by the
+// orders queued ahead of it, the volunteers that would take them and how fast they are.
+// Ties stay with the customer's own depot.
+//
+// With rebalancing on, idle unlimited volunteers move after every tick from depots with
+// no work waiting for their role to depots whose waiting orders outnumber the idle
+// volunteers there, keeping one behind. A driver only moves where it reaches a waiting order.
+// Warehouses find a volunteer by its id as the index of its slot, so a volunteer leaving
+// cannot take its slot with it: a stand-in named NETWORK_VACANT_NAME, a driver that
+// reaches no customer, keeps the slot and id. A volunteer arriving takes over a vacant
+// slot and its id, or is added at the end while the ids still match the slots.
+//
+// Each depot has its own backup; a restore rolls a depot back on its own, volunteers
+// that moved since included.
+class WareHouseNetwork
+{
+public:
+    WareHouseNetwork(const vector<string> &configFilePaths); // Throws std::invalid_argument if a file cannot be read
+    ~WareHouseNetwork();                                     // Stops the depot threads
+    WareHouseNetwork(const WareHouseNetwork &other) = delete;
+    WareHouseNetwork &operator=(const WareHouseNetwork &other) = delete;
+
+    void start();                          // Commands from standard input until close
+    bool execute(const string &userInput); // Run one network command line, false once closed
+    void step(int ticks);
+    int route(int depot, int customerId);  // Places the order, returns the depot it went to or -1
+    int rebalance();                       // Returns the number of volunteers moved
+    void appendSummary(string &buffer) const;
+
+private:
+    void runDepot(NetworkDepot &depot);
+    bool executeAt(NetworkDepot &depot, const string &userInput); // With the depot's backup in place
+    bool moveVolunteer(NetworkDepot &from, size_t index, NetworkDepot &to);
+
+    vector<std::unique_ptr<NetworkDepot>> depots; // Never move: their threads hold them
+    bool rebalancing;
+    int ticks;
+
+    std::mutex mutex;
+    std::condition_variable tickStarted;
+    std::condition_variable tickDone;
+    uint64_t generation; // Ticks started
+    size_t running;      // Depots still stepping the current tick
+    bool stopping;
+};
@@ -1,11 +1,13 @@
 #pragma once
 
+#include <cstdint>
 #include <string>
+#include <string_view>
 #include <vector>
 using std::string;
 using std::vector;
 
-enum class OrderStatus {
+enum class OrderStatus : uint8_t {
     PENDING,
     COLLECTING,
     DELIVERING,
@@ -27,15 +29,17 @@ class Order {
         int getDriverId() const;
         OrderStatus getStatus() const;
         const string toString() const;
+        void appendTo(string &buffer) const; // Append toString() to buffer
 
         int getDistance() const;
-        const string getStatusString(enum OrderStatus sta) const;
+        static std::string_view getStatusString(enum OrderStatus sta);
 
     private:
-        const int id;
-        const int customerId;
-        const int distance;
+        // Packed into 24 bytes: orders are stored by value in an OrderTable
+        int32_t id;
+        int32_t customerId;
+        int32_t collectorId; //Initialized to NO_VOLUNTEER if no collector has been assigned yet
+        int32_t driverId; //Initialized to NO_VOLUNTEER if no driver has been assigned yet
+        int32_t distance;
         OrderStatus status;
-        int collectorId; //Initialized to NO_VOLUNTEER if no collector has been assigned yet
-        int driverId; //Initialized to NO_VOLUNTEER if no driver has been assigned yet
 };
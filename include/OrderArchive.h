@@ -0,0 +1,93 @@
+#pragma once
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+#include "Order.h"
+using std::string;
+using std::vector;
+
+#define ARCHIVE_BLOCK_SIZE 128
+
+// A completed order as read back from the archive.
+struct ArchivedOrder
+{
+    int id;
+    int customerId;
+    int distance;
+    int collectorId;
+    int driverId;
+    int completedTick;
+};
+
+// Append-only columnar store for completed orders.
+// Rows are grouped in blocks of ARCHIVE_BLOCK_SIZE. A full block is sealed: each field
+// becomes a column of fixed-width bit fields, just wide enough for that column's range
+// within the block, stored after the block's smallest value. Ids and ticks are stored
+// as deltas to the previous row, so orders completing in id order cost a bit or two
+// for them. Rows of the block not yet full are kept as they are. Orders mostly
+// complete in id order, so a lookup binary-searches the sealed blocks for the first
+// whose running maximum id reaches the order and only decodes blocks from there on
+// whose range holds it. Sealed blocks are shared, immutable, between copies of the
+// archive: copying it (backups, snapshots) costs one pointer per sealed block.
+class OrderArchive
+{
+private:
+    enum Column
+    {
+        ID,
+        CUSTOMER,
+        DISTANCE,
+        COLLECTOR,
+        DRIVER,
+        TICK,
+        NUM_COLUMNS
+    };
+
+    struct Block
+    {
+        Block();
+        int rows;
+        int minId;
+        int maxId;
+        int runningMaxId;           // Highest id in this and every earlier block
+        int firstId;                // Delta base of the first row
+        int firstTick;
+        int64_t base[NUM_COLUMNS];  // Smallest value (or delta) of each column
+        uint8_t width[NUM_COLUMNS]; // Bits per value; 0 when every value equals base
+        vector<uint64_t> bits;      // The columns one after the other
+    };
+
+public:
+    OrderArchive();
+    void append(const Order &order, int completedTick);
+    bool find(int orderId, ArchivedOrder &result) const; // Returns false if the order is not archived
+    int size() const;
+    size_t memoryUsage() const; // Bytes held by the blocks and open rows, including shared blocks
+
+    // Sequential reader over the archive in completion order
+    class Cursor
+    {
+    public:
+        Cursor(const OrderArchive &archive);
+        bool next(ArchivedOrder &result); // Returns false once every row was read
+
+    private:
+        const OrderArchive &archive;
+        size_t blockIndex; // sealed.size() for the open rows
+        int rowInBlock;
+        int prevId;
+        int prevTick;
+    };
+
+private:
+    static void seal(const vector<ArchivedOrder> &rows, Block &block);
+    static void decodeRow(const Block &block, int row, int &prevId, int &prevTick, ArchivedOrder &result);
+    static size_t blockMemory(const Block &block);
+    int blockRows(size_t index) const; // Sealed blocks first, then the open rows
+    void readRow(size_t blockIndex, int row, int &prevId, int &prevTick, ArchivedOrder &result) const;
+
+    vector<std::shared_ptr<const Block>> sealed;
+    vector<ArchivedOrder> open; // Rows of the block being filled
+    int rows;
+};
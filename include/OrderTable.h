@@ -0,0 +1,53 @@
+#pragma once
+#include <bitset>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include "Order.h"
+
+#define ORDER_CHUNK_SIZE 1024 // Consecutive order ids stored together
+
+// Live (pending and in-process) orders stored by value and indexed by order id.
+// Ids are split into chunks of ORDER_CHUNK_SIZE; a chunk is one contiguous array where
+// the order with id n sits at n % ORDER_CHUNK_SIZE, so a lookup is two array indexings
+// and an order takes its own 24 bytes plus one bit. Chunks are separate allocations
+// and never move, so Order pointers stay valid until retired. A chunk is freed once
+// none of its orders is live, so an order that never completes holds on to its own
+// chunk only, not to those of the orders after it.
+class OrderTable
+{
+public:
+    OrderTable();
+    OrderTable(const OrderTable &other); // Copies the chunks that hold live orders
+    OrderTable &operator=(const OrderTable &other);
+    OrderTable(OrderTable &&other) = default;
+    OrderTable &operator=(OrderTable &&other) = default;
+
+    Order &add(const Order &order); // The id must be higher than any id already added
+    Order &put(const Order &order); // Add or overwrite a live order of any id, for restores
+    Order *find(int orderId);       // Returns nullptr if the order is not live
+    const Order *find(int orderId) const;
+    void retire(int orderId);       // Releases a completed order, and its chunk once empty
+    int size() const;               // Number of live orders
+    size_t memoryUsage() const;     // Approximate bytes held by the table
+
+    void appendLive(vector<Order> &buffer) const; // Copies of the live orders in increasing id order
+
+private:
+    struct Chunk
+    {
+        Chunk();
+        vector<Order> orders; // ORDER_CHUNK_SIZE slots
+        std::bitset<ORDER_CHUNK_SIZE> live;
+        int liveCount;
+    };
+
+    Chunk *chunkOf(int orderId) const; // Nullptr if no order of its chunk is live
+    Order &store(const Order &order);  // Write the order into its slot, creating the chunk
+    void trim();                       // Drop freed chunks at both ends
+
+    std::deque<std::unique_ptr<Chunk>> chunks; // Chunk n holds ids from (firstChunk + n) * ORDER_CHUNK_SIZE; null once freed
+    int firstChunk;
+    int liveOrders;
+    int endId; // One past the highest id added
+};
@@ -0,0 +1,49 @@
+#pragma once
+#include <string>
+#include <string_view>
+#include <vector>
+using std::string;
+
+#define OUTPUT_BUFFER_SIZE (256 * 1024)
+
+// Buffered writer used for every report the warehouse prints.
+// Lines are appended to a large buffer and written with a single write() when it
+// fills up or when flush() is called at a command boundary, instead of flushing on
+// every std::endl. Reports can be redirected to a file and back to stdout, or
+// captured into a string, which is how the socket server collects responses.
+class OutputSink
+{
+public:
+    OutputSink(int fd);
+    ~OutputSink();
+    OutputSink(const OutputSink &other) = delete;
+    OutputSink &operator=(const OutputSink &other) = delete;
+
+    OutputSink &operator<<(std::string_view text);
+    OutputSink &operator<<(const char *text);
+    OutputSink &operator<<(const string &text);
+    OutputSink &operator<<(char c);
+    OutputSink &operator<<(int value);
+    OutputSink &operator<<(long long value);
+    OutputSink &operator<<(size_t value);
+    OutputSink &operator<<(double value);
+
+    void flush();
+    bool redirect(const string &path); // Send output to a file, returns false if it can't be opened
+    void restore();                    // Send output back to stdout
+    bool isRedirected() const;
+    void beginCapture(string &target); // Append output to target instead, until endCapture()
+    void endCapture();
+
+private:
+    void append(const char *data, size_t length);
+    void writeAll(const char *data, size_t length);
+
+    std::vector<char> buffer;
+    size_t used;
+    int fd;
+    int ownedFd; // File opened by redirect(), -1 when writing to stdout
+    string *captureTarget;
+};
+
+extern OutputSink output;
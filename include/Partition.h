@@ -0,0 +1,113 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <sys/types.h>
+#include "ActionLog.h"
+using std::string;
+using std::vector;
+
+#define PARTITION_CONFIG_TEMPLATE "/tmp/warehouse_partition_XXXXXX"
+
+// What the coordinator asks of a partition. Every request gets one reply
+enum class PartitionRequest : int32_t
+{
+    READY,            // Sent by the partition once its configuration is read: ok, or 0 and why not
+    STEP,             // <steps>: 1 once they ran
+    ORDER,            // <customer>: the order id, -1 past the customer's limit
+    CUSTOMER,         // <name> <type> <distance> <max_orders>: ok, then what the action printed
+    ORDER_STATUS,     // <order>: found, status, customer, collector, driver
+    CUSTOMER_STATUS,  // <customer>: found, max orders, count, then order and status pairs
+    VOLUNTEER_STATUS, // <volunteer>: found, id, active order, time left, orders left
+    SUMMARY,          // tick, the WareHouseSummary counts, volunteers, customers
+    BACKUP,           // 1
+    RESTORE,          // ok, then what the action printed
+    CLOSE             // Pending, in-process and completed orders, each a count then order, customer and
+                      // status triples; the partition exits after replying
+};
+
+// One request or reply between the coordinator and a partition: 32-bit integers and
+// length-prefixed strings, framed by a 32-bit byte count. Both ends run on the same
+// machine, so integers go in host byte order.
+class PartitionMessage
+{
+public:
+    PartitionMessage();
+    explicit PartitionMessage(PartitionRequest request);
+
+    void putInt(int32_t value);
+    void putString(const string &text);
+    int32_t getInt(); // Throws std::runtime_error past the end
+    string getString();
+    bool send(int fd) const; // False if the other end is gone
+    bool receive(int fd);    // Replaces the content; false at the end of the stream
+
+private:
+    string bytes;
+    size_t readAt;
+};
+
+// Where a customer, volunteer or order of the whole warehouse lives
+struct PartitionSlot
+{
+    int partition;
+    int localId;
+};
+
+// One warehouse spread over worker processes, so that no process holds all of it.
+// The coordinator reads the configuration once, dealing customers out in turn and
+// collectors and drivers in turns of their own, so every partition gets both roles.
+// Each worker is forked with one end of a Unix domain socket pair and builds its
+// WareHouse from its share. The coordinator keeps no warehouse state, only the ids:
+// customer g lives in partition g % n as local id g / n, and volunteers and orders are
+// mapped both ways by table, 12 bytes an order.
+//
+// Orders go to the partition of their customer and every volunteer works in one
+// partition, so partitions never need each other within a tick. `step` is sent to every
+// partition at once and the coordinator waits for all of them before the next command:
+// that barrier keeps them in step without a round trip per tick. Status queries go to
+// the partition that owns the id and come back as records, printed with global ids.
+// `backup`, `restore`, `summary` and `close` gather the replies of every partition.
+// The action log is the coordinator's, with the records the same commands would log
+// in one process.
+class BaseAction;
+
+class PartitionedWareHouse
+{
+public:
+    // Throws std::invalid_argument if the file cannot be read, std::runtime_error if a partition does not start
+    PartitionedWareHouse(const string &configFilePath, int partitionCount);
+    ~PartitionedWareHouse(); // Ends the partitions still running and waits for them
+    PartitionedWareHouse(const PartitionedWareHouse &other) = delete;
+    PartitionedWareHouse &operator=(const PartitionedWareHouse &other) = delete;
+
+    void start();                          // Commands from standard input until close
+    bool execute(const string &userInput); // Run one command line, false once closed
+
+private:
+    void spawn(const vector<string> &configPaths);
+    PartitionMessage call(int partition, const PartitionMessage &request);  // Throws std::runtime_error if it is gone
+    vector<PartitionMessage> gather(const PartitionMessage &request);      // Sent to all before any reply is read
+    int globalCustomer(int partition, int localId) const;
+    int globalVolunteer(int partition, int localId) const; // NO_VOLUNTEER stays as it is
+    int globalOrder(int partition, int localId) const;     // NO_ORDER stays as it is
+    void appendOrders(string &buffer, int partition, PartitionMessage &reply) const; // One CLOSE section
+    void logAction(const BaseAction &action, ActionError error); // NONE if it completed
+
+    const int partitionCount;
+    vector<pid_t> pids;
+    vector<int> fds;
+    int customerCounter;
+    vector<PartitionSlot> volunteerSlots; // By global id
+    vector<vector<int>> volunteerIds;     // Global ids by partition and local id
+    vector<PartitionSlot> orderSlots;
+    vector<vector<int>> orderIds;
+    ActionLog actionsLog;
+
+    // The ids and log as of the last backup, restored with the partitions
+    bool backedUp;
+    int savedCustomerCounter;
+    vector<PartitionSlot> savedOrderSlots;
+    vector<vector<int>> savedOrderIds;
+    ActionLog savedActionsLog;
+};
@@ -0,0 +1,55 @@
+#pragma once
+#include <string>
+#include <vector>
+using std::string;
+using std::vector;
+
+class WareHouse;
+
+// One re-simulation: the volunteers added and how it went
+struct PlanProbe
+{
+    int collectors; // Added
+    int drivers;    // Added
+    bool met;       // Every open order delivered within the horizon
+    int ticks;      // Ticks it took, the horizon if not met
+};
+
+// Finds the fewest collectors and drivers to add so that every order open now is
+// delivered within the horizon, no new orders coming in. Orders beyond the reach of
+// every driver are counted up front instead, no number of volunteers delivers them.
+// Every probe simulates a copy of the warehouse with the volunteers added. Both counts
+// are first doubled together until the target is met, bounded by the number of open
+// orders since more volunteers of a role than orders cannot help. The collectors are
+// then searched down with the drivers of that bound, and the drivers with the collectors
+// found. The searches take it that a count meeting the target means any larger count
+// does too, which holds up to the order the volunteers are offered orders in.
+// The probes of a round run in parallel the way scenarios do, so a round narrows the
+// range by more than half when there are cores for it.
+class CapacityPlanner
+{
+public:
+    CapacityPlanner(const WareHouse &wareHouse, int horizon); // Throws std::invalid_argument unless horizon > 0
+
+    // "[collector <cooldown>] [driver <max_distance> <distance_per_step>]", the volunteers to add.
+    // A role left out is modelled on the first volunteer of that role in the warehouse.
+    // Throws std::invalid_argument if it is malformed or there is nothing to model on
+    void setVolunteers(const string &text);
+    bool plan();                             // False if the target cannot be met
+    void appendReport(string &buffer) const; // The counts found, or why there are none
+
+private:
+    void runProbes(vector<PlanProbe> &probes);                     // Fills in met and ticks
+    PlanProbe searchMinimum(const PlanProbe &met, bool collectors); // Least count of the role that still meets
+
+    const WareHouse &wareHouse;
+    const int horizon;
+    vector<string> collector; // Configuration lines, named when added
+    vector<string> driver;
+    int openOrders;
+    int unreachable; // Open orders no driver can reach
+    bool found;
+    PlanProbe best;
+    int probesRun;
+    long long elapsedMs;
+};
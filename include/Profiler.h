@@ -0,0 +1,107 @@
+#pragma once
+#include <map>
+#include <mutex>
+#include <string>
+using std::string;
+
+// Hardware events counted around every region, in this order
+enum class ProfileCounter
+{
+    CYCLES,
+    INSTRUCTIONS,
+    L1D_MISSES, // L1 data cache read misses
+    LLC_MISSES, // Last level cache misses
+    BRANCH_MISSES
+};
+#define PROFILE_COUNTERS 5
+
+// The phases of one WareHouse::simulateStep
+enum class ProfilePhase
+{
+    DRAIN,
+    ASSIGN,
+    STEP,
+    FINISH,
+    DELETE,
+    PUBLISH
+};
+#define PROFILE_PHASES 6
+
+#define PROFILE_UNAVAILABLE -1 // Counter value of an event the machine does not count
+
+// Counter readings of the calling thread at one instant
+struct ProfileSample
+{
+    long long nanos;
+    long long counters[PROFILE_COUNTERS];
+    long long enabled; // Time the counters were enabled and actually counting,
+    long long running; // these differ when the kernel multiplexes them
+};
+
+// Sums over every run of one region
+struct ProfileTotals
+{
+    long long calls;
+    long long nanos;
+    long long counters[PROFILE_COUNTERS]; // PROFILE_UNAVAILABLE if not counted
+};
+
+// Hardware performance counters around the simulation phases and the commands.
+// Every thread that samples gets its own group of perf_event_open counters, opened
+// on its first sample and counting user-space events of that thread only; a region
+// is the difference of two samples, scaled up if the kernel multiplexed the group.
+// Where the counters cannot be opened (no PMU, perf_event_paranoid) the regions
+// still get calls and wall time, and the counters read as unavailable.
+class Profiler
+{
+public:
+    Profiler();
+    Profiler(const Profiler &other) = delete;
+    Profiler &operator=(const Profiler &other) = delete;
+
+    ProfileSample sample() const; // Opens the calling thread's counters on first use
+    void addPhase(ProfilePhase phase, const ProfileSample &begin, const ProfileSample &end);
+    void addCommand(const string &command, const ProfileSample &begin); // Ends the command now
+    void reset();
+    void appendReport(string &buffer) const; // One line per phase and per command
+    bool dump(const string &path) const;     // CSV, false if the file can't be written
+
+    static const char *getPhaseString(ProfilePhase phase);
+    static const char *getCounterString(ProfileCounter counter);
+
+private:
+    static void add(ProfileTotals &totals, const ProfileSample &begin, const ProfileSample &end);
+    static void appendTotals(string &buffer, const ProfileTotals &totals);
+    static void appendCsv(string &buffer, const char *kind, const string &name, const ProfileTotals &totals);
+
+    mutable std::mutex mutex; // Phases and commands may run on different threads
+    ProfileTotals phases[PROFILE_PHASES];
+    std::map<string, ProfileTotals> commands; // By the first word of the command line
+};
+
+class Tracer;
+
+// Profiles and traces consecutive phases of one step: each next() ends the running
+// phase and begins another at the same instant, and the whole scope is traced as the
+// tick. Does nothing without a profiler or a tracer.
+class ProfileScope
+{
+public:
+    ProfileScope(Profiler *profiler, Tracer *tracer, int tick, ProfilePhase phase);
+    ~ProfileScope(); // Ends the running phase and the tick
+    ProfileScope(const ProfileScope &other) = delete;
+    ProfileScope &operator=(const ProfileScope &other) = delete;
+
+    void next(ProfilePhase phase);
+
+private:
+    void endPhase();
+
+    Profiler *profiler; // Not owned
+    Tracer *tracer;     // Not owned
+    int tick;
+    ProfilePhase phase;
+    ProfileSample begin;
+    long long tickBegin; // Tracer time
+    long long phaseBegin;
+};
@@ -0,0 +1,71 @@
+#pragma once
+#include <string>
+#include <vector>
+using std::string;
+using std::vector;
+
+class WareHouse;
+
+enum class MutationKind
+{
+    VOLUNTEERS, // "add <count> <role> <args>...", volunteers as in the configuration file
+    ORDERS,     // "orders <count> <customer_id>", placed at the start
+    DEMAND      // "demand <orders_per_tick> <soldier|civilian|all>", placed every tick
+};
+
+struct Mutation
+{
+    MutationKind kind;
+    int count;
+    int customerId;           // ORDERS
+    string customerType;      // DEMAND
+    vector<string> volunteer; // VOLUNTEERS: the configuration line, named when added
+};
+
+// One what-if: the mutations applied to a copy of the warehouse before it runs
+struct Scenario
+{
+    string name; // As written
+    vector<Mutation> mutations;
+};
+
+struct ScenarioResult
+{
+    int completed; // Orders completed within the horizon
+    int open;      // Orders still pending or in process at the horizon
+    long long latencySum;
+    int p95Latency; // Ticks from the start, or from being placed, to completion
+    int maxLatency;
+    long long busyVolunteerTicks;
+    long long volunteerTicks;
+};
+
+// Evaluates what-if scenarios on copies of a warehouse.
+// Every scenario gets its own copy of the warehouse as it is at the command, with a
+// baseline copy that has no mutations. The copies are made and mutated on the calling
+// thread, then simulated to the horizon in parallel, one copy per thread at a time and
+// at most one thread per core. The copies share nothing they write, so the threads
+// need no locks. The original warehouse is left untouched.
+class ScenarioRunner
+{
+public:
+    ScenarioRunner(const WareHouse &wareHouse, int horizon); // Throws std::invalid_argument unless horizon > 0
+
+    static vector<Scenario> parse(const string &text); // "<mutation>, ...; ...", throws std::invalid_argument
+    void run(const vector<Scenario> &scenarios);        // Baseline included; throws std::invalid_argument for an unknown customer
+    void appendTable(string &buffer) const; // One row per scenario, the baseline first
+
+private:
+    struct Run
+    {
+        Scenario scenario;
+        ScenarioResult result;
+    };
+
+    static Mutation parseMutation(const string &text);
+    void evaluate(WareHouse &copy, Run &run) const; // Worker side, runs the copy to the horizon
+
+    const WareHouse &wareHouse;
+    const int horizon;
+    vector<Run> runs;
+};
@@ -0,0 +1,97 @@
+#pragma once
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <sys/epoll.h>
+#include "WareHouse.h"
+#include "Snapshot.h"
+using std::string;
+
+#define SERVER_MAX_EVENTS 64
+#define SERVER_READ_SIZE 65536
+#define SERVER_IDLE_WAIT_MS 100 // How often an idle simulation thread drains the intake
+#define RESPONSE_END "END\n"    // Terminates the response to every command line
+
+// Unix domain socket front-end for a WareHouse.
+// One epoll loop multiplexes every client connection. Clients send the same command
+// lines WareHouse::start() reads from stdin and may pipeline as many as they like;
+// each response ends with RESPONSE_END and responses come back in command order.
+//
+// The WareHouse itself is only touched by a separate simulation thread (and by the
+// SimulationClock between ticks, if one runs), which runs the commands that change it and publishes a Snapshot after every command and every
+// simulated step. orderStatus, customerStatus, volunteerStatus and log are answered
+// on the epoll thread from the latest snapshot, so they never wait behind a long
+// step. A connection does not read past a command that is still with the simulation
+// thread, so a client always sees the effect of its own earlier commands.
+//
+// order and customer lines do not queue up as jobs: every connection is an
+// IntakeQueue producer and submits them without taking a lock. The simulation thread
+// drains the intake before each batch of jobs and hands back what each request
+// printed, which answers the line. Steps and clock ticks leave the intake alone while
+// the server runs, since nothing would answer the requests they applied.
+class Server
+{
+public:
+    Server(WareHouse &wareHouse, const string &socketPath);
+    ~Server();
+    Server(const Server &other) = delete;
+    Server &operator=(const Server &other) = delete;
+
+    void run(); // Serve until a client closes the warehouse
+
+private:
+    struct Connection
+    {
+        explicit Connection(const IntakeQueue::Producer &producer)
+            : input(), output(), interest(EPOLLIN), waiting(false), peerClosed(false), serial(0), producer(producer) {}
+        string input;  // Bytes read but not yet executed
+        string output; // Responses not yet written
+        uint32_t interest; // Events registered with epoll
+        bool waiting;    // A command is with the simulation thread
+        bool peerClosed; // Close once the last pending command was answered
+        unsigned serial; // Tells a reused fd apart from the connection that sent a job
+        IntakeQueue::Producer producer;
+    };
+
+    // A command line handed to the simulation thread, and what it printed
+    struct Job
+    {
+        int fd;
+        unsigned serial;
+        string line;
+        string response;
+    };
+
+    void acceptClients();
+    void readFrom(int fd);
+    void processLines(int fd);
+    bool answerQuery(const string &line, string &response) const; // Returns false if line is not a query
+    bool submitIntake(const string &line, Connection &connection); // Returns false if line is not an order or customer
+    void collectResults();
+    void writeTo(int fd);
+    void updateInterest(int fd);
+    void closeConnection(int fd);
+    void simulate(); // Body of the simulation thread
+
+    WareHouse &wareHouse;
+    string socketPath;
+    int listenFd;
+    int epollFd;
+    int wakeFd; // eventfd the simulation thread signals when results are ready
+    std::unordered_map<int, Connection> connections;
+    std::unordered_map<int, int> producerFds; // Connections by their producer id
+    unsigned nextSerial;
+    SnapshotPublisher publisher;
+
+    std::thread simulation;
+    std::mutex jobsMutex; // Guards everything below
+    std::condition_variable jobsReady;
+    std::deque<Job> jobs;
+    std::deque<Job> results;
+    std::deque<IntakeOutcome> intakeResults;
+    bool closed; // The simulation thread ran close
+};
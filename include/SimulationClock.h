@@ -0,0 +1,58 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <thread>
+using std::string;
+
+class WareHouse;
+
+#define CLOCK_AS_FAST_AS_POSSIBLE 0
+#define CLOCK_WARNING_INTERVAL_MS 1000 // Overrun warnings on stderr are batched this long
+
+// Advances a WareHouse on its own thread, one simulation step per tick.
+// With a tick rate, every tick has a budget of 1/rate seconds. A tick that runs over
+// its budget is an overrun; the ticks it made the clock miss are skipped rather than
+// run back to back, so the clock never bursts to catch up. Overruns are counted for
+// the clock command and summarized on stderr at most once per CLOCK_WARNING_INTERVAL_MS.
+//
+// Commands run between ticks: a thread that changes the warehouse while the clock
+// runs holds holdTick() for the duration, and the clock waits for it.
+class SimulationClock
+{
+public:
+    SimulationClock(WareHouse &wareHouse, int ticksPerSecond); // CLOCK_AS_FAST_AS_POSSIBLE for no pacing
+    ~SimulationClock();
+    SimulationClock(const SimulationClock &other) = delete;
+    SimulationClock &operator=(const SimulationClock &other) = delete;
+
+    void start(); // The warehouse must be open; the clock stops by itself once it is closed
+    void stop();  // Finish the current tick and join the thread
+    std::unique_lock<std::mutex> holdTick(); // Waits for the running tick, blocks the next one
+    void appendReport(string &buffer) const; // Call while holding holdTick()
+
+private:
+    void run();
+    void tick(std::chrono::microseconds budget);
+    void warnOverruns(std::chrono::microseconds budget);
+
+    WareHouse &wareHouse;
+    const int ticksPerSecond;
+    std::thread driver;
+    std::mutex tickMutex;
+    std::condition_variable stopped;
+    std::atomic<bool> running;
+    std::atomic<int> waiting; // Threads blocked in holdTick(), the clock lets them go first
+
+    long long ticks;
+    long long overruns;
+    long long skippedTicks;
+    long long worstTickMicros;
+
+    // Overruns since the last stderr warning
+    long long unreportedOverruns;
+    long long unreportedWorstMicros;
+    std::chrono::steady_clock::time_point lastWarning;
+};
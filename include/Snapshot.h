@@ -0,0 +1,97 @@
+#pragma once
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+#include "Order.h"
+#include "OrderArchive.h"
+#include "Volunteer.h"
+using std::string;
+using std::vector;
+
+class WareHouse;
+class BaseAction;
+
+#define LOG_CHUNK_LINES 64
+#define SNAPSHOT_MIN_INTERVAL_US 1000 // Step boundaries publish at most this often
+#define SNAPSHOT_COST_FACTOR 20       // and wait this many times the last publish's cost, so publishing stays under 5% of a long step
+
+// What a volunteer status report shows, detached from the Volunteer object
+struct VolunteerRecord
+{
+    int id;
+    int activeOrderId; // NO_ORDER when the volunteer is idle
+    int timeLeft;      // Cooldown left for collectors, distance left for drivers
+    int ordersLeft;    // NO_LIMIT for unlimited volunteers
+};
+
+struct CustomerRecord
+{
+    int id;
+    int maxOrders;
+    vector<int> orderIds;
+};
+
+// Immutable copy of everything the read-only status commands look at.
+// The simulation thread publishes a new version at step and command boundaries;
+// readers on other threads hold on to the version they loaded for as long as they
+// need it. Parts that rarely change (sealed archive blocks, customer records, log
+// chunks) are shared between consecutive versions instead of being copied.
+class Snapshot
+{
+public:
+    Snapshot();
+    int getTick() const;
+
+    // Same text as the live status commands; return false if the id is unknown
+    bool orderStatus(int orderId, string &buffer) const;
+    bool customerStatus(int customerId, string &buffer) const;
+    bool volunteerStatus(int volunteerId, string &buffer) const;
+    void log(string &buffer) const;
+
+    // Status report formatting shared with the live WareHouse
+    static void appendOrderStatus(string &buffer, int orderId, OrderStatus status, int customerId, int collectorId, int driverId);
+    static void appendOrderLine(string &buffer, int orderId, OrderStatus status); // One order of a customer status
+    static void appendVolunteerStatus(string &buffer, const VolunteerRecord &volunteer);
+
+private:
+    friend class SnapshotPublisher;
+    bool findOrderStatus(int orderId, OrderStatus &status) const;
+
+    int tick;
+    vector<Order> liveOrders; // Sorted by id
+    OrderArchive completedOrders;
+    vector<VolunteerRecord> volunteers;
+    vector<std::shared_ptr<const CustomerRecord>> customers;
+    vector<std::shared_ptr<const string>> logChunks; // Rendered log lines
+};
+
+// Builds snapshots of one WareHouse and publishes them RCU-style: the newest version
+// is swapped in with an atomic shared_ptr store, and a version is freed when the last
+// reader drops it. Work per publish is proportional to the live orders, volunteers and
+// customers, plus whatever was appended to the log since the last version.
+class SnapshotPublisher
+{
+public:
+    SnapshotPublisher();
+    SnapshotPublisher(const SnapshotPublisher &other) = delete;
+    SnapshotPublisher &operator=(const SnapshotPublisher &other) = delete;
+
+    void publish(const WareHouse &wareHouse);          // Simulation thread only
+    void publishIfStale(const WareHouse &wareHouse);   // Publish unless the latest version is recent for its cost
+    std::shared_ptr<const Snapshot> current() const;   // Any thread
+
+private:
+    void updateCustomers(const WareHouse &wareHouse);
+    void updateLog(const WareHouse &wareHouse);
+
+    std::shared_ptr<const Snapshot> latest;
+    vector<std::shared_ptr<const CustomerRecord>> customers;
+    vector<std::shared_ptr<const string>> logChunks; // Full chunks only
+    string openChunk;                                // Lines after the last full chunk
+    int openChunkLines;
+    size_t loggedActions;
+    int restoreCount; // Detects a state replaced by restore
+    std::chrono::steady_clock::time_point publishedAt;
+    std::chrono::steady_clock::duration publishCost; // Of the last publish
+};
@@ -0,0 +1,46 @@
+#pragma once
+#include <string>
+#include <vector>
+using std::string;
+using std::vector;
+
+#define THROUGHPUT_WINDOWS 3
+#define THROUGHPUT_HISTORY 1000 // Ticks kept, the longest window
+
+// What happened in one tick, or summed over a window of ticks
+struct TickCounts
+{
+    long long created;        // Orders added
+    long long collected;      // Orders a collector finished with
+    long long delivered;      // Orders completed
+    long long busyVolunteers; // Volunteers working in the tick
+    long long volunteers;
+};
+
+// Order rates and volunteer utilization over the last 10, 100 and 1000 ticks.
+// The counts of the running tick go into a ring of the last THROUGHPUT_HISTORY ticks
+// when it ends. Every window keeps its sum, adding the tick that enters it and
+// subtracting the one that leaves, so a tick costs the same whatever the window sizes.
+// The meter follows the ticks as they run; a restore does not rewind it.
+class ThroughputMeter
+{
+public:
+    ThroughputMeter();
+
+    void orderCreated(); // In the running tick
+    void orderCollected();
+    void orderDelivered();
+    void endTick(int busyVolunteers, int volunteers);
+    const TickCounts &getWindow(int window) const; // Sums over the window, 0 is the shortest
+    const TickCounts &getLastTick() const;         // Zero before the first tick
+    int getWindowTicks(int window) const;          // Ticks the window covers so far
+    void appendReport(string &buffer) const;       // One line per window
+
+    static const int windowSizes[THROUGHPUT_WINDOWS];
+
+private:
+    TickCounts current;
+    vector<TickCounts> history; // Ring by tick
+    long long ticks;            // Ticks ended
+    TickCounts sums[THROUGHPUT_WINDOWS];
+};
@@ -0,0 +1,69 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "Order.h"
+#include "Profiler.h"
+using std::string;
+using std::vector;
+
+#define TRACE_RING_EVENTS (1 << 16) // Per thread; the oldest events are overwritten first
+
+enum class TraceEventType : uint8_t
+{
+    TICK,
+    PHASE,
+    ORDER // An order reached a status
+};
+
+struct TraceEvent
+{
+    TraceEventType type;
+    uint8_t detail; // ProfilePhase or OrderStatus
+    int32_t tick;
+    int32_t orderId;
+    int32_t volunteerId; // Who the order went to, NO_VOLUNTEER for PENDING
+    long long begin;     // Nanoseconds since the tracer started
+    long long end;
+};
+
+// Records simulation ticks, their phases and order status changes for offline viewing.
+// Every thread writes into a ring of its own, registered on its first event, with
+// plain stores and one release store of its write count: recording takes no lock
+// and never waits. dump() writes Chrome trace JSON, which chrome://tracing and
+// Perfetto open: ticks and phases are spans on the thread that ran them, and each
+// order's changes are slices on the track of the volunteer that took it, linked by
+// one flow from PENDING to COMPLETED.
+class Tracer
+{
+public:
+    Tracer();
+    Tracer(const Tracer &other) = delete;
+    Tracer &operator=(const Tracer &other) = delete;
+
+    long long now() const;
+    void tick(int tick, long long begin, long long end);
+    void phase(ProfilePhase phase, int tick, long long begin, long long end);
+    void order(const Order &order, int volunteerId, int tick); // The order's current status
+    bool dump(const string &path) const; // At a tick boundary, false if the file can't be written
+
+private:
+    struct Ring
+    {
+        Ring(int threadId);
+        const int threadId;
+        std::atomic<uint64_t> written; // Events ever recorded, the last TRACE_RING_EVENTS are kept
+        vector<TraceEvent> events;
+    };
+
+    void record(const TraceEvent &event);
+    Ring &ring(); // The calling thread's
+
+    const uint64_t id; // Tells the thread-local ring caches of different tracers apart
+    const long long started;
+    mutable std::mutex ringsMutex; // Taken once per thread, to register its ring
+    vector<std::unique_ptr<Ring>> rings;
+};
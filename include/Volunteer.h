@@ -1,12 +1,22 @@
 #pragma once
 #include <string>
 #include <vector>
-#include <sstream>
 #include "Order.h"
+#include "NameTable.h"
 using std::string;
 using std::vector;
 
 #define NO_ORDER -1
+#define NO_LIMIT -1
+
+// The part of a volunteer that changes while the simulation runs
+struct VolunteerTimers
+{
+    int activeOrderId;
+    int completedOrderId;
+    int timeLeft;   // Cooldown left for collectors, distance left for drivers
+    int ordersLeft; // NO_LIMIT for unlimited volunteers
+};
 
 class Volunteer
 {
@@ -14,6 +24,7 @@ public:
     Volunteer(int id, const string &name);
     int getId() const;
     const string &getName() const;
+    NameId getNameId() const;
     int getActiveOrderId() const;
     int getCompletedOrderId() const;
     bool isBusy() const;                                     // Signal whether the volunteer is currently processing an order
@@ -23,8 +34,11 @@ public:
 
     virtual void step() = 0; // Simulate volunteer step,if the volunteer finished the order, transfer activeOrderId to completedOrderId
 
-    virtual string toString() const = 0;
+    string toString() const;
+    virtual void appendTo(string &buffer) const = 0; // Append toString() to buffer
     virtual Volunteer *clone() const = 0; // Return a copy of the volunteer
+    virtual VolunteerTimers getTimers() const;
+    virtual void setTimers(const VolunteerTimers &timers); // Put the volunteer back into a saved state
 
     virtual ~Volunteer() = default;
 protected:
@@ -32,16 +46,18 @@ protected:
     int activeOrderId;    // Initialized to NO_ORDER if no order is being processed
 
 private:
-    const int id;
-    const string name;
+    int id;
+    NameId name; // Interned in NameTable
 };
 
 class CollectorVolunteer : public Volunteer
 {
 
 public:
-    CollectorVolunteer(int id, const string &name, int coolDown);
+    CollectorVolunteer(int id, const string &name, int coolDown, int waveSize = 1);
     CollectorVolunteer *clone() const override;
+    VolunteerTimers getTimers() const override;
+    void setTimers(const VolunteerTimers &timers) override;
     void step() override;
     int getCoolDown() const;
     int getTimeLeft() const;
@@ -49,29 +65,37 @@ public:
     bool hasOrdersLeft() const override;
     bool canTakeOrder(const Order &order) const override;
     void acceptOrder(const Order &order) override;
-    string toString() const override;
+    int getWaveSize() const;
+    virtual int getWaveRoom() const;              // Orders that can still join the wave acceptOrder just started
+    virtual void joinWave(const Order &order);    // Collect the order in the same cooldown
+    void appendTo(string &buffer) const override;
 
 private:
-    const int coolDown; // The time it takes the volunteer to process an order
+    int coolDown; // The time it takes the volunteer to process an order
     int timeLeft;       // Time left until the volunteer finishes his current order
+    int waveSize; // Orders collected in one cooldown, 1 unless wave picking
 };
 
 class LimitedCollectorVolunteer : public CollectorVolunteer
 {
 
 public:
-    LimitedCollectorVolunteer(int id, const string &name, int coolDown, int maxOrders);
+    LimitedCollectorVolunteer(int id, const string &name, int coolDown, int maxOrders, int waveSize = 1);
     LimitedCollectorVolunteer *clone() const override;
+    VolunteerTimers getTimers() const override;
+    void setTimers(const VolunteerTimers &timers) override;
     bool hasOrdersLeft() const override;
     bool canTakeOrder(const Order &order) const override;
     void acceptOrder(const Order &order) override;
+    int getWaveRoom() const override; // No more than the orders left
+    void joinWave(const Order &order) override;
 
     int getMaxOrders() const;
     int getNumOrdersLeft() const;
-    string toString() const override;
+    void appendTo(string &buffer) const override;
 
 private:
-    const int maxOrders; // The number of orders the volunteer can process in the whole simulation
+    int maxOrders; // The number of orders the volunteer can process in the whole simulation
     int ordersLeft;      // The number of orders the volunteer can still take
 };
 
@@ -81,6 +105,8 @@ class DriverVolunteer : public Volunteer
 public:
     DriverVolunteer(int id, const string &name, int maxDistance, int distancePerStep);
     DriverVolunteer *clone() const override;
+    VolunteerTimers getTimers() const override;
+    void setTimers(const VolunteerTimers &timers) override;
 
     int getDistanceLeft() const;
     int getMaxDistance() const;
@@ -90,11 +116,11 @@ public:
     bool canTakeOrder(const Order &order) const override; // Signal if the volunteer is not busy and the order is within the maxDistance
     void acceptOrder(const Order &order) override;        // Assign distanceLeft to order's distance
     void step() override;                                 // Decrease distanceLeft by distancePerStep
-    string toString() const override;
+    void appendTo(string &buffer) const override;
 
 private:
-    const int maxDistance;     // The maximum distance of ANY order the volunteer can take
-    const int distancePerStep; // The distance the volunteer does in one step
+    int maxDistance;     // The maximum distance of ANY order the volunteer can take
+    int distancePerStep; // The distance the volunteer does in one step
     int distanceLeft;          // Distance left until the volunteer finishes his current order
 };
 
@@ -104,14 +130,16 @@ class LimitedDriverVolunteer : public DriverVolunteer
 public:
     LimitedDriverVolunteer(int id, const string &name, int maxDistance, int distancePerStep, int maxOrders);
     LimitedDriverVolunteer *clone() const override;
+    VolunteerTimers getTimers() const override;
+    void setTimers(const VolunteerTimers &timers) override;
     int getMaxOrders() const;
     int getNumOrdersLeft() const;
     bool hasOrdersLeft() const override;
     bool canTakeOrder(const Order &order) const override; // Signal if the volunteer is not busy, the order is within the maxDistance.
     void acceptOrder(const Order &order) override;        // Assign distanceLeft to order's distance and decrease ordersLeft
-    string toString() const override;
+    void appendTo(string &buffer) const override;
 
 private:
-    const int maxOrders; // The number of orders the volunteer can process in the whole simulation
+    int maxOrders; // The number of orders the volunteer can process in the whole simulation
     int ordersLeft;      // The number of orders the volunteer can still take
 };
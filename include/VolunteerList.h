@@ -0,0 +1,65 @@
+#pragma once
+#include <variant>
+#include <vector>
+#include "Volunteer.h"
+using std::vector;
+
+// One volunteer stored by value as its concrete type
+typedef std::variant<CollectorVolunteer, LimitedCollectorVolunteer, DriverVolunteer, LimitedDriverVolunteer> VolunteerSlot;
+
+// The volunteers of a WareHouse, stored by value in one contiguous vector.
+// No volunteer has a heap allocation of its own and copying the list for a backup is
+// a copy of the vector. The simulation loops std::visit the slots and make qualified
+// calls on the concrete type, which bind statically and can be inlined. Elsewhere the
+// list reads like the vector of Volunteer pointers it replaces: indexing and iteration
+// yield pointers into the slots, valid until the list changes.
+//
+// The engine looks volunteers up by id as an index into the list. Once deletions shrink
+// the list, the vector of pointers it replaces still held, past its end, the pointer
+// the slot had before the erase, and the step loop read volunteers through it. The
+// list remembers which volunteer each slot past the end last held so that lookup stays
+// defined and gives the same answers; a copy starts with no such slots.
+class VolunteerList
+{
+public:
+    VolunteerList();
+    VolunteerList(const VolunteerList &other);
+    VolunteerList &operator=(const VolunteerList &other);
+    void add(const Volunteer &volunteer); // Copies the volunteer into a slot of its type
+    void replace(size_t index, const Volunteer &volunteer); // The same, in place of the slot's volunteer
+    void erase(size_t index);
+    void clear();
+    size_t size() const;
+    int staleId(size_t index) const; // Id last held by a slot past the end, NO_VOLUNTEER if none
+    Volunteer *operator[](size_t index);
+    const Volunteer *operator[](size_t index) const;
+    vector<VolunteerSlot> &getSlots(); // For std::visit
+    const vector<VolunteerSlot> &getSlots() const;
+
+    template <class List, class Pointer>
+    class Iterator
+    {
+    public:
+        Iterator(List &list, size_t index) : list(list), index(index) {}
+        Pointer operator*() const { return list[index]; }
+        Iterator &operator++()
+        {
+            index++;
+            return *this;
+        }
+        bool operator!=(const Iterator &other) const { return index != other.index; }
+
+    private:
+        List &list;
+        size_t index;
+    };
+
+    Iterator<VolunteerList, Volunteer *> begin() { return Iterator<VolunteerList, Volunteer *>(*this, 0); }
+    Iterator<VolunteerList, Volunteer *> end() { return Iterator<VolunteerList, Volunteer *>(*this, size()); }
+    Iterator<const VolunteerList, const Volunteer *> begin() const { return Iterator<const VolunteerList, const Volunteer *>(*this, 0); }
+    Iterator<const VolunteerList, const Volunteer *> end() const { return Iterator<const VolunteerList, const Volunteer *>(*this, size()); }
+
+private:
+    vector<VolunteerSlot> slots;
+    vector<int> staleIds; // By slot index, NO_VOLUNTEER below size()
+};
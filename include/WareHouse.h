@@ -2,13 +2,38 @@
 #include <string>
 #include <vector>
 #include <algorithm>
+#include <mutex>
 
 #include "Order.h"
 #include "Customer.h"
+#include "OrderArchive.h"
+#include "OrderTable.h"
+#include "IntakeQueue.h"
+#include "Snapshot.h"
+#include "ActionLog.h"
+#include "Checkpoint.h"
+#include "VolunteerList.h"
+#include "BackgroundSave.h"
+#include "Throughput.h"
+#include "Demand.h"
 
 class BaseAction;
+class SimulationClock;
+class Profiler;
+class Tracer;
 class Volunteer;
 
+// Counts the warehouse keeps up to date on every change, so reading them is O(1)
+struct WareHouseSummary
+{
+    int pendingOrders; // By order status
+    int collectingOrders;
+    int deliveringOrders;
+    int completedOrders;
+    int busyVolunteers;   // Processing an order
+    int customersAtLimit; // Made maxOrders orders
+};
+
 // Warehouse responsible for Volunteers, Customers Actions, and Orders.
 
 class WareHouse
@@ -17,14 +42,19 @@ class WareHouse
 public:
     WareHouse(const string &configFilePath);
     void start();
-    void addOrder(Order *order);
-    void addAction(BaseAction *action);
+    bool execute(const string &userInput); // Run one command line, false if it could not be parsed
+    void addOrder(const Order &order);
+    bool placeOrder(Customer &customer); // As AddOrder does, without logging or printing; false past the customer's limit
+    void addAction(const BaseAction &action); // Logs the action's record
+    void amendLastAction(const BaseAction &action); // Replaces the record logged last, once the action's outcome changed
     Customer &getCustomer(int customerId) const;
     Volunteer &getVolunteer(int volunteerId) const;
-    Order &getOrder(int orderId) const;
-    const vector<BaseAction *> &getActions() const;
+    Order &getOrder(int orderId) const; // Pending or in-process orders only, completed ones are archived
+    OrderStatus getOrderStatus(int orderId) const;
+    const ActionLog &getActions() const;
     void close();
     void open();
+    bool isOpened() const;
     
     //rule of five
     ~WareHouse();
@@ -36,15 +66,25 @@ public:
     int getCustomerCounter() const;
     int getVolunteerCounter() const;
     int getOrderCounter() const;
+    int getCurrentTick() const;
     void setOrderCounter(); // Add 1 to orderCounter
     void readConfigAndSetup(const string &configFilePath);
     void addCustomer(Customer *customer);
     void addCustomer(const string &customerName, const string &customerType, int distance, int maxOrders);
-    void addVolunteer(Volunteer *volunteer);
+    void addVolunteer(const Volunteer &volunteer); // Stored by value
+    void addVolunteer(const vector<string> &tokens); // "volunteer <name> <role> <args>..." as in the configuration file
+    void replaceVolunteer(size_t index, const Volunteer &volunteer); // Both idle; keeps every other volunteer where it is
     const vector<Order *> &getPendingOrders() const;
     const vector<Order *> &getInProcessOrders() const;
-    const vector<Order *> &getCompletedOrders() const;
+    const OrderTable &getLiveOrders() const; // Pending and in-process orders by id
+    const OrderArchive &getCompletedOrders() const;
     const vector<Customer *> &getCustomers() const;
+    const VolunteerList &getVolunteers() const;
+    VolunteerRecord getVolunteerRecord(const Volunteer *volunteer) const;
+    int getRestoreCount() const; // Number of times the whole state was replaced by assignment
+    const WareHouseSummary &getSummary() const;
+    void appendSummary(string &buffer) const;
+    const ThroughputMeter &getThroughput() const;
 
     int getInstanceOfVolunteer(Volunteer *volunteer) const;
     int printOrderStatus(int orderId);
@@ -55,18 +95,58 @@ public:
     void assignOrdersToVolunteers();
     void performSimulationStep();
     void checkVolunteerFinishedOrders();
+    const Volunteer *volunteerAtIndex(int volunteerIndex) const; // Nullptr if none
+    int finishedOrder(int volunteerIndex) const;
+    bool finishedWave(int volunteerIndex, const Order &order) const;
     void deleteMaxOrdersVolunteers();
 
+    IntakeQueue &getIntake(); // Producer threads submit orders and customers here
+    int drainIntake(vector<IntakeOutcome> *outcomes = nullptr); // Apply queued requests, simulation thread only; what each printed if given
+    void setStepsDrainIntake(bool drain);             // false while a caller drains at its own boundaries and answers the producers
+    void setPublisher(SnapshotPublisher *publisher); // Publish a snapshot after every step, nullptr to stop
+    void setClock(SimulationClock *clock);           // start() runs it and waits for tick boundaries
+    void setProfiler(Profiler *profiler);            // Count every step phase and command, nullptr to stop
+    void setTracer(Tracer *tracer);                  // Trace every tick, phase and order change, nullptr to stop
+    CheckpointStore &getCheckpoints();
+    BackgroundSave &getBackgroundSave();
+    std::unique_lock<std::mutex> holdClock();        // Keeps the clock between ticks; an empty lock without one
+
 private:
+    friend class CheckpointStore; // Saves and rebuilds the state piece by piece
+    bool executeCommand(const string &userInput);
+    void relinkOrderQueues(const WareHouse &other);
+    void assignCustomers(const WareHouse &other); // operator= helper, reuses the customers both sides share
+    void clearState(); // Empty warehouse, counts as a restore
+    void recountSummary(); // Recompute the summary from scratch after rebuilding the state
+
     bool isOpen;
-    vector<BaseAction *> actionsLog;
-    vector<Volunteer *> volunteers;
-    vector<Order *> pendingOrders;
+    ActionLog actionsLog;
+    VolunteerList volunteers;
+    OrderTable orders;             // Owns every live order by value
+    vector<Order *> pendingOrders; // Point into orders
     vector<Order *> inProcessOrders;
-    vector<Order *> completedOrders;
+    size_t pendingFrom;   // No pending order sits in pendingOrders before this index; 0 is always safe
+    size_t collectedFrom; // Nor a collected one waiting for a driver before this
+    OrderArchive completedOrders;
     vector<Customer *> customers;
     int customerCounter;  // For assigning unique customer IDs
     int volunteerCounter; // For assigning unique volunteer IDs
 
     int orderCounter; // For assigning unique order IDs
+    int currentTick;  // Number of simulation steps performed so far
+    WareHouseSummary summary;
+
+    // Belongs to this object rather than its state: copies and moves start with an empty queue
+    IntakeQueue intake;
+    vector<IntakeRequest> intakeBatch;
+    bool stepsDrainIntake;
+    SnapshotPublisher *publisher; // Not owned
+    SimulationClock *clock;       // Not owned
+    Profiler *profiler;           // Not owned
+    Tracer *tracer;               // Not owned
+    CheckpointStore checkpoints;  // Named checkpoints are not part of the state either
+    BackgroundSave backgroundSave;
+    ThroughputMeter throughput; // Measures the ticks this object ran
+    DemandGenerator demand;     // Places orders in the ticks this object runs
+    int restoreCount;
 };
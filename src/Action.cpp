@@ -1,9 +1,11 @@
 #include "../include/Action.h"
+#include "../include/OutputSink.h"
+#include "../include/Format.h"
 
 // BaseAction implementation
-BaseAction::BaseAction() : errorMsg(""), status(ActionStatus::COMPLETED) {}
+BaseAction::BaseAction() : errorCode(ActionError::NONE), status(ActionStatus::COMPLETED) {}
 
-const string BaseAction::getStatusString(enum ActionStatus sta) const
+std::string_view BaseAction::getStatusString(enum ActionStatus sta)
 {
     switch (sta)
     {
@@ -15,7 +17,7 @@ const string BaseAction::getStatusString(enum ActionStatus sta) const
     return "";
 }
 
-const string BaseAction::getCustomerTypeString(enum CustomerType ct) const
+std::string_view BaseAction::getCustomerTypeString(enum CustomerType ct)
 {
     switch (ct)
     {
@@ -27,9 +29,37 @@ const string BaseAction::getCustomerTypeString(enum CustomerType ct) const
     return "";
 }
 
+void BaseAction::appendTo(string &buffer) const
+{
+    ActionLog::appendCommand(toRecord(), getRecordText(), buffer);
+}
+
+string BaseAction::toString() const
+{
+    string buffer;
+    appendTo(buffer);
+    return buffer;
+}
+
 void BaseAction::print() const
 {
-    std::cout << this->toString() << " " << this->getStatusString(this->getStatus()) << std::endl;
+    string buffer;
+    print(buffer);
+}
+
+void BaseAction::print(string &buffer) const
+{
+    buffer.clear();
+    appendLogLine(buffer);
+    output << buffer;
+}
+
+void BaseAction::appendLogLine(string &buffer) const
+{
+    appendTo(buffer);
+    buffer += ' ';
+    appendText(buffer, getStatusString(getStatus()));
+    buffer += '\n';
 }
 
 ActionStatus BaseAction::getStatus() const
@@ -42,16 +72,26 @@ void BaseAction::complete()
     status = ActionStatus::COMPLETED;
 }
 
-void BaseAction::error(string errorMsg)
+void BaseAction::error(ActionError errorCode)
 {
     status = ActionStatus::ERROR;
-    this->errorMsg = errorMsg;
-    std::cout << "Error: " << errorMsg << std::endl; // Print error message to the screen
+    this->errorCode = errorCode;
+    output << "Error: " << getActionErrorText(errorCode) << '\n'; // Print error message to the screen
 }
 
 string BaseAction::getErrorMsg() const
 {
-    return errorMsg;
+    return string(getActionErrorText(errorCode));
+}
+
+ActionRecord BaseAction::makeRecord(ActionKind kind, int32_t arg0, int32_t arg1, int32_t arg2, int32_t arg3) const
+{
+    return ActionRecord{kind, status, errorCode, {arg0, arg1, arg2, arg3}};
+}
+
+std::string_view BaseAction::getRecordText() const
+{
+    return std::string_view();
 }
 
 // simulateStep
@@ -62,12 +102,12 @@ void SimulateStep::act(WareHouse &wareHouse)
 {
     wareHouse.simulateStep(numOfSteps);
     complete();
-    wareHouse.addAction(this->clone());
+    wareHouse.addAction(*this);
 }
 
-std::string SimulateStep::toString() const
+ActionRecord SimulateStep::toRecord() const
 {
-    return "simulateStep " + std::to_string(numOfSteps);
+    return makeRecord(ActionKind::STEP, numOfSteps);
 }
 
 SimulateStep *SimulateStep::clone() const
@@ -93,20 +133,30 @@ void Close::act(WareHouse &wareHouse)
     wareHouse.close();
 
     complete();
-    wareHouse.addAction(this->clone());
+    wareHouse.addAction(*this);
 }
 
 void Close::printOrders(const vector<Order *> &orders) const
 {
     for (const auto &order : orders)
     {
-        std::cout << "OrderID: " << order->getId() << " , CustomerID: " << order->getCustomerId() << " , Status: " << order->getStatusString(order->getStatus()) << std::endl;
+        output << "OrderID: " << order->getId() << " , CustomerID: " << order->getCustomerId() << " , Status: " << order->getStatusString(order->getStatus()) << '\n';
     }
 }
 
-string Close::toString() const
+void Close::printOrders(const OrderArchive &orders) const
 {
-    return "close ";
+    OrderArchive::Cursor cursor(orders);
+    ArchivedOrder order;
+    while (cursor.next(order))
+    {
+        output << "OrderID: " << order.id << " , CustomerID: " << order.customerId << " , Status: COMPLETED\n";
+    }
+}
+
+ActionRecord Close::toRecord() const
+{
+    return makeRecord(ActionKind::CLOSE);
 }
 
 Close *Close::clone() const
@@ -119,14 +169,16 @@ BackupWareHouse::BackupWareHouse() {}
 
 void BackupWareHouse::act(WareHouse &wareHouse)
 {
-    // Delete previous backup if exists
-    if (backup != nullptr)
+    // Create a new backup by cloning the current warehouse, or overwrite the previous one in place
+    wareHouse.addAction(*this);
+    if (backup == nullptr)
+    {
+        backup = new WareHouse(wareHouse);
+    }
+    else
     {
-        delete backup;
+        *backup = wareHouse;
     }
-    // Create a new backup by cloning the current warehouse
-    wareHouse.addAction(this->clone());
-    backup = new WareHouse(wareHouse);
     complete();
 }
 
@@ -135,9 +187,9 @@ BackupWareHouse *BackupWareHouse::clone() const
     return new BackupWareHouse(*this);
 }
 
-string BackupWareHouse::toString() const
+ActionRecord BackupWareHouse::toRecord() const
 {
-    return "backup";
+    return makeRecord(ActionKind::BACKUP);
 }
 
 // Restore
@@ -148,7 +200,7 @@ void RestoreWareHouse::act(WareHouse &wareHouse)
     // Check if backup is available
     if (backup == nullptr)
     {
-        error("No backup available");
+        error(ActionError::NO_BACKUP);
     }
     else
     {
@@ -156,7 +208,7 @@ void RestoreWareHouse::act(WareHouse &wareHouse)
         wareHouse = *backup;
         complete();
     }
-    wareHouse.addAction(this->clone());
+    wareHouse.addAction(*this);
 }
 
 RestoreWareHouse *RestoreWareHouse::clone() const
@@ -164,9 +216,155 @@ RestoreWareHouse *RestoreWareHouse::clone() const
     return new RestoreWareHouse(*this);
 }
 
-string RestoreWareHouse::toString() const
+ActionRecord RestoreWareHouse::toRecord() const
+{
+    return makeRecord(ActionKind::RESTORE);
+}
+
+// SaveCheckpoint
+SaveCheckpoint::SaveCheckpoint(const string &name) : name(name) {}
+
+void SaveCheckpoint::act(WareHouse &wareHouse)
+{
+    CheckpointStore &checkpoints = wareHouse.getCheckpoints();
+    if (checkpoints.contains(name))
+    {
+        error(ActionError::CHECKPOINT_EXISTS);
+        wareHouse.addAction(*this);
+    }
+    else
+    {
+        // Logged before saving so the checkpoint holds its own action, like backup
+        complete();
+        wareHouse.addAction(*this);
+        checkpoints.save(name, wareHouse);
+    }
+}
+
+SaveCheckpoint *SaveCheckpoint::clone() const
+{
+    return new SaveCheckpoint(*this);
+}
+
+ActionRecord SaveCheckpoint::toRecord() const
+{
+    return makeRecord(ActionKind::SAVE_CHECKPOINT);
+}
+
+std::string_view SaveCheckpoint::getRecordText() const
+{
+    return name;
+}
+
+// RestoreCheckpoint
+RestoreCheckpoint::RestoreCheckpoint(const string &name) : name(name) {}
+
+void RestoreCheckpoint::act(WareHouse &wareHouse)
+{
+    if (wareHouse.getCheckpoints().restore(name, wareHouse))
+        complete();
+    else
+        error(ActionError::CHECKPOINT_MISSING);
+    wareHouse.addAction(*this);
+}
+
+RestoreCheckpoint *RestoreCheckpoint::clone() const
+{
+    return new RestoreCheckpoint(*this);
+}
+
+ActionRecord RestoreCheckpoint::toRecord() const
+{
+    return makeRecord(ActionKind::RESTORE_CHECKPOINT);
+}
+
+std::string_view RestoreCheckpoint::getRecordText() const
+{
+    return name;
+}
+
+// PrintCheckpoints
+PrintCheckpoints::PrintCheckpoints() {}
+
+void PrintCheckpoints::act(WareHouse &wareHouse)
+{
+    string report;
+    wareHouse.getCheckpoints().appendList(report);
+    output << report;
+    complete();
+    wareHouse.addAction(*this);
+}
+
+PrintCheckpoints *PrintCheckpoints::clone() const
+{
+    return new PrintCheckpoints(*this);
+}
+
+ActionRecord PrintCheckpoints::toRecord() const
+{
+    return makeRecord(ActionKind::CHECKPOINTS);
+}
+
+// SaveSnapshot
+SaveSnapshot::SaveSnapshot(const string &path) : path(path) {}
+
+void SaveSnapshot::act(WareHouse &wareHouse)
+{
+    BackgroundSave &save = wareHouse.getBackgroundSave();
+    if (save.isRunning())
+    {
+        error(ActionError::SAVE_RUNNING);
+        wareHouse.addAction(*this);
+    }
+    else
+    {
+        // Logged before the fork so the snapshot holds its own action, like backup
+        complete();
+        wareHouse.addAction(*this);
+        if (!save.start(path, wareHouse))
+        {
+            // Nothing was written, so the log shows the failure after all
+            error(ActionError::SAVE_NOT_STARTED);
+            wareHouse.amendLastAction(*this);
+        }
+    }
+}
+
+SaveSnapshot *SaveSnapshot::clone() const
+{
+    return new SaveSnapshot(*this);
+}
+
+ActionRecord SaveSnapshot::toRecord() const
+{
+    return makeRecord(ActionKind::SAVE);
+}
+
+std::string_view SaveSnapshot::getRecordText() const
+{
+    return path;
+}
+
+// PrintSaveStatus
+PrintSaveStatus::PrintSaveStatus() {}
+
+void PrintSaveStatus::act(WareHouse &wareHouse)
+{
+    string status;
+    wareHouse.getBackgroundSave().appendStatus(status);
+    output << status;
+    complete();
+    wareHouse.addAction(*this);
+}
+
+PrintSaveStatus *PrintSaveStatus::clone() const
+{
+    return new PrintSaveStatus(*this);
+}
+
+ActionRecord PrintSaveStatus::toRecord() const
 {
-    return "restore";
+    return makeRecord(ActionKind::SAVE_STATUS);
 }
 
 // AddOrder
@@ -185,9 +383,8 @@ void AddOrder::act(WareHouse &wareHouse)
             isSucceeded = customer->addOrder(wareHouse.getOrderCounter());
             if (isSucceeded > -1)
             {
-                Order *orderToAdd = new Order(wareHouse.getOrderCounter(), customerId, customer->getCustomerDistance());
+                wareHouse.addOrder(Order(wareHouse.getOrderCounter(), customerId, customer->getCustomerDistance()));
                 wareHouse.setOrderCounter();
-                wareHouse.addOrder(orderToAdd);
                 complete();
             }
             break;
@@ -196,14 +393,14 @@ void AddOrder::act(WareHouse &wareHouse)
     // If customer ID doesn't exist or adding order failed
     if (existId == false || isSucceeded == -1)
     {
-        error("Cannot place this order");
+        error(ActionError::CANNOT_PLACE_ORDER);
     }
-    wareHouse.addAction(this->clone());
+    wareHouse.addAction(*this);
 }
 
-string AddOrder::toString() const
+ActionRecord AddOrder::toRecord() const
 {
-    return "order " + std::to_string(customerId);
+    return makeRecord(ActionKind::ORDER, customerId);
 }
 
 AddOrder *AddOrder::clone() const
@@ -212,13 +409,13 @@ AddOrder *AddOrder::clone() const
 }
 
 AddCustomer::AddCustomer(const string &customerName, const string &customerType, int distance, int maxOrders)
-    : customerName(customerName), customerType(static_cast<CustomerType>(customerTypeStringToInt(customerType))), distance(distance), maxOrders(maxOrders) {}
+    : customerName(NameTable::intern(customerName)), customerType(static_cast<CustomerType>(customerTypeStringToInt(customerType))), distance(distance), maxOrders(maxOrders) {}
 
 void AddCustomer::act(WareHouse &wareHouse)
 {
-    wareHouse.addCustomer(customerName, getCustomerTypeString(customerType), distance, maxOrders);
+    wareHouse.addCustomer(NameTable::lookup(customerName), string(getCustomerTypeString(customerType)), distance, maxOrders);
     complete();
-    wareHouse.addAction(this->clone());
+    wareHouse.addAction(*this);
 }
 
 int AddCustomer::customerTypeStringToInt(const string &cType)
@@ -229,9 +426,9 @@ int AddCustomer::customerTypeStringToInt(const string &cType)
         return 2;
 }
 
-string AddCustomer::toString() const
+ActionRecord AddCustomer::toRecord() const
 {
-    return "customer " + customerName + getCustomerTypeString(customerType) + std::to_string(distance) + std::to_string(maxOrders);
+    return makeRecord(ActionKind::CUSTOMER, customerName, static_cast<int32_t>(customerType), distance, maxOrders);
 }
 
 AddCustomer *AddCustomer::clone() const
@@ -248,13 +445,13 @@ void PrintOrderStatus::act(WareHouse &wareHouse)
     if (isSucceeded != -1)
         complete();
     else
-        error("Order doesnt exist");
-    wareHouse.addAction(this->clone());
+        error(ActionError::ORDER_MISSING);
+    wareHouse.addAction(*this);
 }
 
-string PrintOrderStatus::toString() const
+ActionRecord PrintOrderStatus::toRecord() const
 {
-    return "orderStatus " + std::to_string(orderId);
+    return makeRecord(ActionKind::ORDER_STATUS, orderId);
 }
 
 PrintOrderStatus *PrintOrderStatus::clone() const
@@ -271,13 +468,13 @@ void PrintCustomerStatus::act(WareHouse &wareHouse)
     if (isSucceeded != -1)
         complete();
     else
-        error("Customer doesnt exist");
-    wareHouse.addAction(this->clone());
+        error(ActionError::CUSTOMER_MISSING);
+    wareHouse.addAction(*this);
 }
 
-string PrintCustomerStatus::toString() const
+ActionRecord PrintCustomerStatus::toRecord() const
 {
-    return "customerStatus " + std::to_string(this->customerId);
+    return makeRecord(ActionKind::CUSTOMER_STATUS, customerId);
 }
 
 PrintCustomerStatus *PrintCustomerStatus::clone() const
@@ -294,13 +491,13 @@ void PrintVolunteerStatus::act(WareHouse &wareHouse)
     if (isSucceeded != -1)
         complete();
     else
-        error("Volunteer doesnt exist");
-    wareHouse.addAction(this->clone());
+        error(ActionError::VOLUNTEER_MISSING);
+    wareHouse.addAction(*this);
 }
 
-string PrintVolunteerStatus::toString() const
+ActionRecord PrintVolunteerStatus::toRecord() const
 {
-    return "volunteerStatus " + std::to_string(volunteerId);
+    return makeRecord(ActionKind::VOLUNTEER_STATUS, volunteerId);
 }
 
 PrintVolunteerStatus *PrintVolunteerStatus::clone() const
@@ -314,19 +511,24 @@ PrintActionsLog::PrintActionsLog() {}
 
 void PrintActionsLog::act(WareHouse &wareHouse)
 {
-    const vector<BaseAction *> &actions = wareHouse.getActions();
-    for (BaseAction *act : actions)
+    // One line buffer for the whole log, so printing allocates nothing per line
+    const ActionLog &actions = wareHouse.getActions();
+    string line;
+    line.reserve(64);
+    for (size_t i = 0; i < actions.size(); i++)
     {
-        act->print();
+        line.clear();
+        actions.appendLine(i, line);
+        output << line;
     }
 
     complete();
-    wareHouse.addAction(this->clone());
+    wareHouse.addAction(*this);
 }
 
-string PrintActionsLog::toString() const
+ActionRecord PrintActionsLog::toRecord() const
 {
-    return "log";
+    return makeRecord(ActionKind::LOG);
 }
 
 PrintActionsLog *PrintActionsLog::clone() const
@@ -0,0 +1,170 @@
+#include "../include/ActionLog.h"
+#include "../include/Action.h"
+#include "../include/Format.h"
+
+// Indexed by ActionError
+static const std::string_view ACTION_ERROR_TEXT[] = {
+    "",
+    "No backup available",
+    "Checkpoint already exists",
+    "Checkpoint doesnt exist",
+    "A save is already in progress",
+    "Cannot start the save",
+    "Cannot place this order",
+    "Order doesnt exist",
+    "Customer doesnt exist",
+    "Volunteer doesnt exist"};
+
+std::string_view getActionErrorText(ActionError error)
+{
+    return ACTION_ERROR_TEXT[static_cast<size_t>(error)];
+}
+
+ActionError findActionError(std::string_view text)
+{
+    for (size_t i = 1; i < sizeof(ACTION_ERROR_TEXT) / sizeof(ACTION_ERROR_TEXT[0]); i++)
+    {
+        if (ACTION_ERROR_TEXT[i] == text)
+            return static_cast<ActionError>(i);
+    }
+    return ActionError::NONE;
+}
+
+ActionLog::ActionLog() : records(), text() {}
+
+void ActionLog::append(const ActionRecord &record, std::string_view recordText)
+{
+    records.push_back(record);
+    if (hasText(record.kind))
+    {
+        records.back().args[0] = static_cast<int32_t>(text.size());
+        records.back().args[1] = static_cast<int32_t>(recordText.size());
+        text.append(recordText);
+    }
+}
+
+void ActionLog::append(const ActionLog &other, size_t index)
+{
+    append(other.records[index], other.getText(index));
+}
+
+void ActionLog::replaceLast(const ActionRecord &record)
+{
+    ActionRecord &last = records.back();
+    int32_t textOffset = last.args[0];
+    int32_t textLength = last.args[1];
+    last = record;
+    if (hasText(record.kind))
+    {
+        last.args[0] = textOffset;
+        last.args[1] = textLength;
+    }
+}
+
+void ActionLog::clear()
+{
+    records.clear();
+    text.clear();
+}
+
+size_t ActionLog::size() const
+{
+    return records.size();
+}
+
+const ActionRecord &ActionLog::operator[](size_t index) const
+{
+    return records[index];
+}
+
+std::string_view ActionLog::getText(size_t index) const
+{
+    const ActionRecord &record = records[index];
+    if (!hasText(record.kind))
+        return std::string_view();
+    return std::string_view(text).substr(record.args[0], record.args[1]);
+}
+
+size_t ActionLog::memoryUsage() const
+{
+    return records.capacity() * sizeof(ActionRecord) + text.capacity();
+}
+
+bool ActionLog::hasText(ActionKind kind)
+{
+    return kind == ActionKind::SAVE_CHECKPOINT || kind == ActionKind::RESTORE_CHECKPOINT || kind == ActionKind::SAVE;
+}
+
+void ActionLog::appendLine(size_t index, string &buffer) const
+{
+    const ActionRecord &record = records[index];
+    appendCommand(record, getText(index), buffer);
+    buffer += ' ';
+    appendText(buffer, BaseAction::getStatusString(record.status));
+    buffer += '\n';
+}
+
+void ActionLog::appendCommand(const ActionRecord &record, std::string_view text, string &buffer)
+{
+    const int32_t *args = record.args;
+    switch (record.kind)
+    {
+    case ActionKind::STEP:
+        appendText(buffer, "simulateStep ");
+        appendInt(buffer, args[0]);
+        break;
+    case ActionKind::ORDER:
+        appendText(buffer, "order ");
+        appendInt(buffer, args[0]);
+        break;
+    case ActionKind::CUSTOMER:
+        appendText(buffer, "customer ");
+        appendText(buffer, NameTable::lookup(args[0]));
+        appendText(buffer, BaseAction::getCustomerTypeString(static_cast<CustomerType>(args[1])));
+        appendInt(buffer, args[2]);
+        appendInt(buffer, args[3]);
+        break;
+    case ActionKind::ORDER_STATUS:
+        appendText(buffer, "orderStatus ");
+        appendInt(buffer, args[0]);
+        break;
+    case ActionKind::CUSTOMER_STATUS:
+        appendText(buffer, "customerStatus ");
+        appendInt(buffer, args[0]);
+        break;
+    case ActionKind::VOLUNTEER_STATUS:
+        appendText(buffer, "volunteerStatus ");
+        appendInt(buffer, args[0]);
+        break;
+    case ActionKind::LOG:
+        appendText(buffer, "log");
+        break;
+    case ActionKind::CLOSE:
+        appendText(buffer, "close ");
+        break;
+    case ActionKind::BACKUP:
+        appendText(buffer, "backup");
+        break;
+    case ActionKind::RESTORE:
+        appendText(buffer, "restore");
+        break;
+    case ActionKind::SAVE_CHECKPOINT:
+        appendText(buffer, "backup ");
+        appendText(buffer, text);
+        break;
+    case ActionKind::RESTORE_CHECKPOINT:
+        appendText(buffer, "restore ");
+        appendText(buffer, text);
+        break;
+    case ActionKind::CHECKPOINTS:
+        appendText(buffer, "checkpoints");
+        break;
+    case ActionKind::SAVE:
+        appendText(buffer, "save ");
+        appendText(buffer, text);
+        break;
+    case ActionKind::SAVE_STATUS:
+        appendText(buffer, "saveStatus");
+        break;
+    }
+}
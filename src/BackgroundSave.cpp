@@ -0,0 +1,303 @@
+#include "../include/BackgroundSave.h"
+#include "../include/WareHouse.h"
+#include "../include/Customer.h"
+#include "../include/Volunteer.h"
+#include "../include/Action.h"
+#include "../include/Format.h"
+
+#include <cerrno>
+#include <cstring>
+#include <new>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+using std::chrono::duration;
+using std::chrono::steady_clock;
+
+BackgroundSave::BackgroundSave()
+    : progress(nullptr), child(-1), state(State::IDLE), path(), totalRows(0), tick(0), started()
+{
+}
+
+BackgroundSave::~BackgroundSave()
+{
+    poll(true);
+    if (progress != nullptr)
+    {
+        progress->~Progress();
+        munmap(progress, sizeof(Progress));
+    }
+}
+
+bool BackgroundSave::start(const string &path, const WareHouse &wareHouse)
+{
+    if (isRunning())
+    {
+        return false;
+    }
+    if (progress == nullptr)
+    {
+        void *shared = mmap(nullptr, sizeof(Progress), PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+        if (shared == MAP_FAILED)
+        {
+            return false;
+        }
+        progress = new (shared) Progress();
+    }
+    progress->rows = 0;
+    progress->bytes = 0;
+    progress->error = 0;
+    progress->finishedAt = 0;
+
+    pid_t pid = fork();
+    if (pid < 0)
+    {
+        return false;
+    }
+    if (pid == 0)
+    {
+        // Child: only this thread exists here, so touch nothing but the warehouse image
+        // and leave with _exit(), without running destructors or flushing the parent's buffers
+        int error = write(wareHouse, path, *progress);
+        progress->error = error;
+        progress->finishedAt = steady_clock::now().time_since_epoch().count();
+        _exit(error == 0 ? 0 : 1);
+    }
+
+    child = pid;
+    state = State::RUNNING;
+    this->path = path;
+    totalRows = static_cast<long long>(wareHouse.getCustomers().size()) + wareHouse.getVolunteers().size() +
+                wareHouse.getPendingOrders().size() + wareHouse.getInProcessOrders().size() +
+                wareHouse.getCompletedOrders().size() + wareHouse.getActions().size();
+    tick = wareHouse.getCurrentTick();
+    started = steady_clock::now();
+    return true;
+}
+
+bool BackgroundSave::isRunning()
+{
+    poll(false);
+    return state == State::RUNNING;
+}
+
+void BackgroundSave::poll(bool wait)
+{
+    if (state != State::RUNNING)
+    {
+        return;
+    }
+    int status = 0;
+    pid_t result;
+    do
+    {
+        result = waitpid(child, &status, wait ? 0 : WNOHANG);
+    } while (result < 0 && errno == EINTR);
+    if (result == 0)
+    {
+        return;
+    }
+    child = -1;
+    bool succeeded = result > 0 && WIFEXITED(status) && WEXITSTATUS(status) == 0;
+    state = succeeded ? State::DONE : State::FAILED;
+}
+
+void BackgroundSave::appendStatus(string &buffer)
+{
+    poll(false);
+    if (state == State::IDLE)
+    {
+        appendText(buffer, "No background save\n");
+        return;
+    }
+
+    long long rows = progress->rows;
+    steady_clock::time_point end = steady_clock::now();
+    if (state != State::RUNNING && progress->finishedAt != 0)
+    {
+        end = steady_clock::time_point(steady_clock::duration(progress->finishedAt));
+    }
+    int millis = static_cast<int>(duration<double, std::milli>(end - started).count());
+    switch (state)
+    {
+    case State::RUNNING:
+        appendText(buffer, "Save in progress: ");
+        break;
+    case State::DONE:
+        appendText(buffer, "Save completed: ");
+        break;
+    default:
+        appendText(buffer, "Save failed: ");
+        break;
+    }
+    appendText(buffer, path);
+    appendText(buffer, ", Tick: ");
+    appendInt(buffer, tick);
+    appendText(buffer, ", Rows: ");
+    appendInt(buffer, rows);
+    appendText(buffer, "/");
+    appendInt(buffer, totalRows);
+    appendText(buffer, " (");
+    appendInt(buffer, totalRows == 0 ? 100 : rows * 100 / totalRows);
+    appendText(buffer, "%), Bytes: ");
+    appendInt(buffer, progress->bytes);
+    appendText(buffer, ", Time: ");
+    appendInt(buffer, millis);
+    appendText(buffer, " ms");
+    if (state == State::FAILED)
+    {
+        appendText(buffer, ", Error: ");
+        int error = progress->error;
+        appendText(buffer, error != 0 ? strerror(error) : "save process was killed");
+    }
+    buffer += '\n';
+}
+
+// Hand the buffered part of the snapshot to the file, returns errno or 0
+static int flushSnapshot(int fd, string &buffer, std::atomic<long long> &bytes)
+{
+    size_t written = 0;
+    while (written < buffer.size())
+    {
+        ssize_t result = ::write(fd, buffer.data() + written, buffer.size() - written);
+        if (result < 0)
+        {
+            if (errno == EINTR)
+                continue;
+            return errno;
+        }
+        written += result;
+        bytes += result;
+    }
+    buffer.clear();
+    return 0;
+}
+
+int BackgroundSave::write(const WareHouse &wareHouse, const string &path, Progress &progress)
+{
+    string tmpPath = path + ".tmp";
+    int fd = ::open(tmpPath.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (fd < 0)
+    {
+        return errno;
+    }
+
+    string buffer;
+    buffer.reserve(SAVE_BUFFER_SIZE + 256);
+    int error = 0;
+    // Count a finished row and write the buffer once it is full
+    auto row = [&]() {
+        buffer += '\n';
+        progress.rows++;
+        if (buffer.size() >= SAVE_BUFFER_SIZE && error == 0)
+        {
+            error = flushSnapshot(fd, buffer, progress.bytes);
+        }
+    };
+
+    appendText(buffer, "Tick: ");
+    appendInt(buffer, wareHouse.getCurrentTick());
+    appendText(buffer, ", Customer counter: ");
+    appendInt(buffer, wareHouse.getCustomerCounter());
+    appendText(buffer, ", Volunteer counter: ");
+    appendInt(buffer, wareHouse.getVolunteerCounter());
+    appendText(buffer, ", Order counter: ");
+    appendInt(buffer, wareHouse.getOrderCounter());
+    appendText(buffer, "\n");
+
+    appendText(buffer, "Customers:\n");
+    for (const Customer *customer : wareHouse.getCustomers())
+    {
+        customer->appendTo(buffer);
+        appendText(buffer, ", Orders:");
+        for (int orderId : customer->getOrdersIds())
+        {
+            buffer += ' ';
+            appendInt(buffer, orderId);
+        }
+        row();
+    }
+
+    appendText(buffer, "Volunteers:\n");
+    for (const Volunteer *volunteer : wareHouse.getVolunteers())
+    {
+        volunteer->appendTo(buffer);
+        appendText(buffer, ", Active Order: ");
+        appendInt(buffer, volunteer->getActiveOrderId());
+        appendText(buffer, ", Completed Order: ");
+        appendInt(buffer, volunteer->getCompletedOrderId());
+        row();
+    }
+
+    appendText(buffer, "Orders:\n");
+    for (const vector<Order *> *queue : {&wareHouse.getPendingOrders(), &wareHouse.getInProcessOrders()})
+    {
+        for (const Order *order : *queue)
+        {
+            appendText(buffer, "OrderID: ");
+            appendInt(buffer, order->getId());
+            appendText(buffer, " , CustomerID: ");
+            appendInt(buffer, order->getCustomerId());
+            appendText(buffer, " , Distance: ");
+            appendInt(buffer, order->getDistance());
+            appendText(buffer, " , Status: ");
+            appendText(buffer, Order::getStatusString(order->getStatus()));
+            appendText(buffer, " , CollectorID: ");
+            appendInt(buffer, order->getCollectorId());
+            appendText(buffer, " , DriverID: ");
+            appendInt(buffer, order->getDriverId());
+            row();
+        }
+    }
+    OrderArchive::Cursor cursor(wareHouse.getCompletedOrders());
+    ArchivedOrder order;
+    while (cursor.next(order))
+    {
+        appendText(buffer, "OrderID: ");
+        appendInt(buffer, order.id);
+        appendText(buffer, " , CustomerID: ");
+        appendInt(buffer, order.customerId);
+        appendText(buffer, " , Distance: ");
+        appendInt(buffer, order.distance);
+        appendText(buffer, " , Status: COMPLETED , CollectorID: ");
+        appendInt(buffer, order.collectorId);
+        appendText(buffer, " , DriverID: ");
+        appendInt(buffer, order.driverId);
+        appendText(buffer, " , CompletedTick: ");
+        appendInt(buffer, order.completedTick);
+        row();
+    }
+
+    appendText(buffer, "Actions:\n");
+    const ActionLog &actions = wareHouse.getActions();
+    for (size_t i = 0; i < actions.size(); i++)
+    {
+        actions.appendLine(i, buffer);
+        buffer.pop_back(); // row() ends the line
+        row();
+    }
+
+    if (error == 0)
+    {
+        error = flushSnapshot(fd, buffer, progress.bytes);
+    }
+    if (error == 0 && fsync(fd) != 0)
+    {
+        error = errno;
+    }
+    if (::close(fd) != 0 && error == 0)
+    {
+        error = errno;
+    }
+    if (error == 0 && rename(tmpPath.c_str(), path.c_str()) != 0)
+    {
+        error = errno;
+    }
+    if (error != 0)
+    {
+        unlink(tmpPath.c_str());
+    }
+    return error;
+}
@@ -0,0 +1,338 @@
+#include "../include/Checkpoint.h"
+#include "../include/WareHouse.h"
+#include "../include/Customer.h"
+#include "../include/Format.h"
+
+#include <algorithm>
+
+static bool sameOrder(const Order &a, const Order &b)
+{
+    return a.getId() == b.getId() && a.getStatus() == b.getStatus() && a.getCustomerId() == b.getCustomerId() &&
+           a.getCollectorId() == b.getCollectorId() && a.getDriverId() == b.getDriverId() && a.getDistance() == b.getDistance();
+}
+
+static bool sameTimers(const VolunteerTimers &a, const VolunteerTimers &b)
+{
+    return a.activeOrderId == b.activeOrderId && a.completedOrderId == b.completedOrderId &&
+           a.timeLeft == b.timeLeft && a.ordersLeft == b.ordersLeft;
+}
+
+// Checkpoint implementation
+
+Checkpoint::Checkpoint(const string &name, int parent)
+    : name(name), parent(parent), customerCounter(0), volunteerCounter(0), orderCounter(0), currentTick(0),
+      changedOrders(), retiredOrders(), pendingOrders(), inProcessOrders(), completedOrders(),
+      newVolunteers(), volunteers(), changedTimers(), newCustomers(), newCustomerOrders(), newActions() {}
+
+Checkpoint::~Checkpoint()
+{
+    for (Customer *customer : newCustomers)
+    {
+        delete customer;
+    }
+}
+
+size_t Checkpoint::deltaBytes() const
+{
+    size_t ids = retiredOrders.size() + pendingOrders.removed.size() + pendingOrders.appended.size() + inProcessOrders.removed.size() +
+                 inProcessOrders.appended.size() + volunteers.removed.size() + volunteers.appended.size();
+    return changedOrders.size() * sizeof(Order) + ids * sizeof(int) +
+           changedTimers.size() * sizeof(changedTimers[0]) + newCustomerOrders.size() * sizeof(newCustomerOrders[0]) +
+           newVolunteers.size() * sizeof(LimitedDriverVolunteer) + newCustomers.size() * sizeof(SoldierCustomer) +
+           newActions.memoryUsage();
+}
+
+// CheckpointStore implementation
+
+CheckpointStore::Image::Image()
+    : orders(), pendingOrders(), inProcessOrders(), volunteers(), timers(), volunteerCounter(0), customerOrders(), actions(0) {}
+
+CheckpointStore::CheckpointStore() : checkpoints(), head(NO_PARENT), headRestoreCount(0), image() {}
+
+CheckpointStore::~CheckpointStore()
+{
+    for (Checkpoint *checkpoint : checkpoints)
+    {
+        delete checkpoint;
+    }
+}
+
+int CheckpointStore::find(const string &name) const
+{
+    for (size_t i = 0; i < checkpoints.size(); i++)
+    {
+        if (checkpoints[i]->name == name)
+        {
+            return static_cast<int>(i);
+        }
+    }
+    return NO_PARENT;
+}
+
+bool CheckpointStore::contains(const string &name) const
+{
+    return find(name) != NO_PARENT;
+}
+
+ListDelta CheckpointStore::diff(const vector<int> &before, const vector<int> &after)
+{
+    // The survivors are the longest prefix of after that is a subsequence of before
+    ListDelta delta;
+    size_t kept = 0;
+    for (int id : before)
+    {
+        if (kept < after.size() && after[kept] == id)
+            kept++;
+        else
+            delta.removed.push_back(id);
+    }
+    delta.appended.assign(after.begin() + kept, after.end());
+    std::sort(delta.removed.begin(), delta.removed.end());
+    return delta;
+}
+
+void CheckpointStore::apply(const ListDelta &delta, vector<int> &list)
+{
+    if (!delta.removed.empty())
+    {
+        list.erase(std::remove_if(list.begin(), list.end(), [&delta](int id)
+                                  { return std::binary_search(delta.removed.begin(), delta.removed.end(), id); }),
+                   list.end());
+    }
+    list.insert(list.end(), delta.appended.begin(), delta.appended.end());
+}
+
+bool CheckpointStore::save(const string &name, const WareHouse &wareHouse)
+{
+    if (find(name) != NO_PARENT)
+    {
+        return false;
+    }
+
+    // Anything but our own restore replaced the state: start over from an empty warehouse
+    bool fromHead = head != NO_PARENT && wareHouse.getRestoreCount() == headRestoreCount;
+    if (!fromHead)
+    {
+        image = Image();
+    }
+    Checkpoint *checkpoint = new Checkpoint(name, fromHead ? head : NO_PARENT);
+    checkpoint->customerCounter = wareHouse.customerCounter;
+    checkpoint->volunteerCounter = wareHouse.volunteerCounter;
+    checkpoint->orderCounter = wareHouse.orderCounter;
+    checkpoint->currentTick = wareHouse.currentTick;
+
+    // Both lists are in increasing id order: walk them side by side
+    vector<Order> live;
+    wareHouse.orders.appendLive(live);
+    size_t seen = 0;
+    for (const Order &order : live)
+    {
+        while (seen < image.orders.size() && image.orders[seen].getId() < order.getId())
+        {
+            checkpoint->retiredOrders.push_back(image.orders[seen++].getId());
+        }
+        if (seen < image.orders.size() && image.orders[seen].getId() == order.getId())
+        {
+            if (!sameOrder(order, image.orders[seen]))
+                checkpoint->changedOrders.push_back(order);
+            seen++;
+        }
+        else
+        {
+            checkpoint->changedOrders.push_back(order);
+        }
+    }
+    for (; seen < image.orders.size(); seen++)
+    {
+        checkpoint->retiredOrders.push_back(image.orders[seen].getId());
+    }
+    vector<int> ids;
+    for (const Order *order : wareHouse.pendingOrders)
+        ids.push_back(order->getId());
+    checkpoint->pendingOrders = diff(image.pendingOrders, ids);
+    ids.clear();
+    for (const Order *order : wareHouse.inProcessOrders)
+        ids.push_back(order->getId());
+    checkpoint->inProcessOrders = diff(image.inProcessOrders, ids);
+    checkpoint->completedOrders = wareHouse.completedOrders;
+
+    ids.clear();
+    for (const Volunteer *volunteer : wareHouse.volunteers)
+    {
+        ids.push_back(volunteer->getId());
+        if (volunteer->getId() >= image.volunteerCounter)
+        {
+            checkpoint->newVolunteers.add(*volunteer);
+        }
+        else if (!sameTimers(volunteer->getTimers(), image.timers[volunteer->getId()]))
+        {
+            checkpoint->changedTimers.push_back(std::make_pair(volunteer->getId(), volunteer->getTimers()));
+        }
+    }
+    checkpoint->volunteers = diff(image.volunteers, ids);
+
+    // Customers and their order lists, like the action log, only grow
+    const vector<Customer *> &customers = wareHouse.customers;
+    for (size_t i = 0; i < customers.size(); i++)
+    {
+        if (i >= image.customerOrders.size())
+        {
+            checkpoint->newCustomers.push_back(customers[i]->clone());
+            continue;
+        }
+        const vector<int> &orderIds = customers[i]->getOrdersIds();
+        for (size_t j = image.customerOrders[i]; j < orderIds.size(); j++)
+        {
+            checkpoint->newCustomerOrders.push_back(std::make_pair(i, orderIds[j]));
+        }
+    }
+    for (size_t i = image.actions; i < wareHouse.actionsLog.size(); i++)
+    {
+        checkpoint->newActions.append(wareHouse.actionsLog, i);
+    }
+
+    checkpoints.push_back(checkpoint);
+    head = static_cast<int>(checkpoints.size()) - 1;
+    headRestoreCount = wareHouse.getRestoreCount();
+    capture(wareHouse);
+    return true;
+}
+
+bool CheckpointStore::restore(const string &name, WareHouse &wareHouse)
+{
+    int index = find(name);
+    if (index == NO_PARENT)
+    {
+        return false;
+    }
+    vector<const Checkpoint *> chain;
+    for (int i = index; i != NO_PARENT; i = checkpoints[i]->parent)
+    {
+        chain.push_back(checkpoints[i]);
+    }
+    std::reverse(chain.begin(), chain.end());
+
+    wareHouse.clearState();
+    vector<int> pendingIds;
+    vector<int> inProcessIds;
+    vector<int> volunteerIds;
+    for (const Checkpoint *checkpoint : chain)
+    {
+        for (int id : checkpoint->retiredOrders)
+        {
+            wareHouse.orders.retire(id);
+        }
+        for (const Order &order : checkpoint->changedOrders)
+        {
+            wareHouse.orders.put(order);
+        }
+        apply(checkpoint->pendingOrders, pendingIds);
+        apply(checkpoint->inProcessOrders, inProcessIds);
+
+        for (const Volunteer *volunteer : checkpoint->newVolunteers)
+        {
+            wareHouse.volunteers.add(*volunteer);
+        }
+        apply(checkpoint->volunteers, volunteerIds);
+        for (const auto &changed : checkpoint->changedTimers)
+        {
+            for (Volunteer *volunteer : wareHouse.volunteers)
+            {
+                if (volunteer->getId() == changed.first)
+                    volunteer->setTimers(changed.second);
+            }
+        }
+
+        for (const Customer *customer : checkpoint->newCustomers)
+        {
+            wareHouse.customers.push_back(customer->clone());
+        }
+        for (const auto &order : checkpoint->newCustomerOrders)
+        {
+            wareHouse.customers[order.first]->addOrder(order.second);
+        }
+        for (size_t i = 0; i < checkpoint->newActions.size(); i++)
+        {
+            wareHouse.actionsLog.append(checkpoint->newActions, i);
+        }
+    }
+
+    // Volunteers that left on the way were cloned by an ancestor, drop them now
+    VolunteerList &volunteers = wareHouse.volunteers;
+    vector<int> sortedIds(volunteerIds);
+    std::sort(sortedIds.begin(), sortedIds.end());
+    for (size_t i = 0; i < volunteers.size();)
+    {
+        if (std::binary_search(sortedIds.begin(), sortedIds.end(), volunteers[i]->getId()))
+        {
+            ++i;
+            continue;
+        }
+        volunteers.erase(i);
+    }
+
+    const Checkpoint *target = chain.back();
+    for (int id : pendingIds)
+        wareHouse.pendingOrders.push_back(wareHouse.orders.find(id));
+    for (int id : inProcessIds)
+        wareHouse.inProcessOrders.push_back(wareHouse.orders.find(id));
+    wareHouse.completedOrders = target->completedOrders;
+    wareHouse.customerCounter = target->customerCounter;
+    wareHouse.volunteerCounter = target->volunteerCounter;
+    wareHouse.orderCounter = target->orderCounter;
+    wareHouse.currentTick = target->currentTick;
+    wareHouse.recountSummary();
+
+    head = index;
+    headRestoreCount = wareHouse.getRestoreCount();
+    capture(wareHouse);
+    return true;
+}
+
+void CheckpointStore::capture(const WareHouse &wareHouse)
+{
+    image.orders.clear();
+    wareHouse.orders.appendLive(image.orders);
+    image.pendingOrders.clear();
+    for (const Order *order : wareHouse.pendingOrders)
+        image.pendingOrders.push_back(order->getId());
+    image.inProcessOrders.clear();
+    for (const Order *order : wareHouse.inProcessOrders)
+        image.inProcessOrders.push_back(order->getId());
+
+    image.volunteerCounter = wareHouse.volunteerCounter;
+    image.volunteers.clear();
+    image.timers.assign(image.volunteerCounter, VolunteerTimers{NO_ORDER, NO_ORDER, 0, NO_LIMIT});
+    for (const Volunteer *volunteer : wareHouse.volunteers)
+    {
+        image.volunteers.push_back(volunteer->getId());
+        image.timers[volunteer->getId()] = volunteer->getTimers();
+    }
+
+    image.customerOrders.clear();
+    for (const Customer *customer : wareHouse.customers)
+    {
+        image.customerOrders.push_back(customer->getOrdersIds().size());
+    }
+    image.actions = wareHouse.actionsLog.size();
+}
+
+void CheckpointStore::appendList(string &buffer) const
+{
+    for (const Checkpoint *checkpoint : checkpoints)
+    {
+        appendText(buffer, "Checkpoint: ");
+        appendText(buffer, checkpoint->name);
+        appendText(buffer, ", Tick: ");
+        appendInt(buffer, checkpoint->currentTick);
+        appendText(buffer, ", Parent: ");
+        appendText(buffer, checkpoint->parent == NO_PARENT ? "None" : checkpoints[checkpoint->parent]->name);
+        appendText(buffer, ", Changed orders: ");
+        appendInt(buffer, checkpoint->changedOrders.size());
+        appendText(buffer, ", New actions: ");
+        appendInt(buffer, checkpoint->newActions.size());
+        appendText(buffer, ", Delta bytes: ");
+        appendInt(buffer, checkpoint->deltaBytes());
+        buffer += '\n';
+    }
+}
@@ -1,10 +1,15 @@
 #include "../include/Customer.h"
-#include <sstream>
+#include "../include/Format.h"
 
 Customer::Customer(int id, const string &name, int locationDistance, int maxOrders)
-    : id(id), name(name), locationDistance(locationDistance), maxOrders(maxOrders), ordersId() {}
+    : id(id), name(NameTable::intern(name)), locationDistance(locationDistance), maxOrders(maxOrders), ordersId() {}
 
 const string &Customer::getName() const
+{
+    return NameTable::lookup(name);
+}
+
+NameId Customer::getNameId() const
 {
     return name;
 }
@@ -39,6 +44,11 @@ const vector<int> &Customer::getOrdersIds() const
     return ordersId;
 }
 
+void Customer::setOrdersIds(const vector<int> &ordersIds)
+{
+    ordersId = ordersIds;
+}
+
 int Customer::addOrder(int orderId)
 {
     if (canMakeOrder())
@@ -59,12 +69,7 @@ SoldierCustomer::SoldierCustomer(int id, const string &name, int locationDistanc
 // SoldierCustomer clone function definition
 SoldierCustomer *SoldierCustomer::clone() const
 {
-    SoldierCustomer *clone = new SoldierCustomer(getId(), getName(), getCustomerDistance(), getMaxOrders());
-    for (int orderId : getOrdersIds())
-    {
-        clone->addOrder(orderId);
-    }
-    return clone;
+    return new SoldierCustomer(*this);
 }
 
 // CivilianCustomer constructor definition
@@ -74,28 +79,37 @@ CivilianCustomer::CivilianCustomer(int id, const string &name, int locationDista
 // CivilianCustomer clone function definition
 CivilianCustomer *CivilianCustomer::clone() const
 {
-    CivilianCustomer *clone = new CivilianCustomer(getId(), getName(), getCustomerDistance(), getMaxOrders());
-    for (int orderId : getOrdersIds())
-    {
-        clone->addOrder(orderId);
-    }
-    return clone;
+    return new CivilianCustomer(*this);
 }
 
 // toStrings
-std::string Customer::toString() const
+string Customer::toString() const
 {
-    std::stringstream ss;
-    ss << "Customer ID: " << id << ", Name: " << name << ", Location Distance: " << locationDistance << ", Max Orders: " << maxOrders;
-    return ss.str();
+    string buffer;
+    appendTo(buffer);
+    return buffer;
 }
 
-std::string SoldierCustomer::toString() const
+void Customer::appendTo(string &buffer) const
 {
-    return "Soldier Customer: " + Customer::toString();
+    appendText(buffer, "Customer ID: ");
+    appendInt(buffer, id);
+    appendText(buffer, ", Name: ");
+    appendText(buffer, getName());
+    appendText(buffer, ", Location Distance: ");
+    appendInt(buffer, locationDistance);
+    appendText(buffer, ", Max Orders: ");
+    appendInt(buffer, maxOrders);
 }
 
-std::string CivilianCustomer::toString() const
+void SoldierCustomer::appendTo(string &buffer) const
 {
-    return "Civilian Customer: " + Customer::toString();
-}
\ No newline at end of file
+    appendText(buffer, "Soldier Customer: ");
+    Customer::appendTo(buffer);
+}
+
+void CivilianCustomer::appendTo(string &buffer) const
+{
+    appendText(buffer, "Civilian Customer: ");
+    Customer::appendTo(buffer);
+}
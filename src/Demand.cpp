@@ -0,0 +1,205 @@
+#include "../include/Demand.h"
+#include "../include/WareHouse.h"
+#include "../include/Customer.h"
+#include "../include/Format.h"
+
+#include <cmath>
+#include <sstream>
+#include <stdexcept>
+
+#define POISSON_CHUNK 30.0 // Largest mean drawn at once, e^-mean stays well inside a double
+
+DemandGenerator::DemandGenerator() : random(DEMAND_DEFAULT_SEED), seed(DEMAND_DEFAULT_SEED), processes() {}
+
+void DemandGenerator::setSeed(uint64_t seed)
+{
+    this->seed = seed;
+    random.seed(seed);
+    for (ArrivalProcess &process : processes)
+    {
+        process.on = true;
+    }
+}
+
+// A finite number at least minimum, the whole token
+static double parseNumber(const string &token, double minimum)
+{
+    size_t used = 0;
+    double value = -1;
+    try
+    {
+        value = std::stod(token, &used);
+    }
+    catch (const std::exception &)
+    {
+        used = 0;
+    }
+    if (used != token.size() || !std::isfinite(value) || value < minimum)
+    {
+        throw std::invalid_argument("Not a number of at least " + std::to_string(static_cast<int>(minimum)) + ": " + token);
+    }
+    return value;
+}
+
+void DemandGenerator::add(const string &text)
+{
+    std::istringstream stream(text);
+    vector<string> tokens;
+    string token;
+    while (stream >> token)
+    {
+        tokens.push_back(token);
+    }
+    string words;
+    for (const string &word : tokens)
+    {
+        words += words.empty() ? word : " " + word;
+    }
+
+    ArrivalProcess process = {words, "", ArrivalModel::POISSON, 0, 1, 1, true, 0, 0, {}, 0, -1};
+    if (tokens.empty() || (tokens[0] != "soldier" && tokens[0] != "civilian" && tokens[0] != "all"))
+    {
+        throw std::invalid_argument("Unknown customer type: " + words);
+    }
+    process.customerType = tokens[0];
+    if (tokens.size() == 3 && tokens[1] == "poisson")
+    {
+        process.rate = parseNumber(tokens[2], 0);
+    }
+    else if (tokens.size() == 5 && tokens[1] == "onoff")
+    {
+        process.model = ArrivalModel::ON_OFF;
+        process.rate = parseNumber(tokens[2], 0);
+        process.onTicks = parseNumber(tokens[3], 1);
+        process.offTicks = parseNumber(tokens[4], 1);
+    }
+    else
+    {
+        throw std::invalid_argument("Unknown arrival process: " + words);
+    }
+    processes.push_back(process);
+}
+
+void DemandGenerator::clear()
+{
+    processes.clear();
+}
+
+bool DemandGenerator::isActive() const
+{
+    return !processes.empty();
+}
+
+double DemandGenerator::uniform()
+{
+    // The top 53 bits, as many as a double holds
+    return static_cast<double>(random() >> 11) * (1.0 / 9007199254740992.0);
+}
+
+long long DemandGenerator::poisson(double mean)
+{
+    // Poisson counts add up, so a large mean is drawn in chunks. Each chunk counts the
+    // uniforms multiplied in before the product falls below e^-chunk
+    long long count = 0;
+    while (mean > 0)
+    {
+        double chunk = std::min(mean, POISSON_CHUNK);
+        mean -= chunk;
+        double limit = std::exp(-chunk);
+        for (double product = uniform(); product >= limit; product *= uniform())
+        {
+            count++;
+        }
+    }
+    return count;
+}
+
+static bool matchesType(const Customer *customer, const string &customerType)
+{
+    if (customerType == "soldier")
+        return dynamic_cast<const SoldierCustomer *>(customer) != nullptr;
+    if (customerType == "civilian")
+        return dynamic_cast<const CivilianCustomer *>(customer) != nullptr;
+    return true;
+}
+
+void DemandGenerator::refresh(ArrivalProcess &process, const WareHouse &wareHouse) const
+{
+    // A restore replaces the customers, look at all of them again
+    if (process.restoreCount != wareHouse.getRestoreCount())
+    {
+        process.restoreCount = wareHouse.getRestoreCount();
+        process.customerIds.clear();
+        process.customersSeen = 0;
+    }
+    const vector<Customer *> &customers = wareHouse.getCustomers();
+    for (; process.customersSeen < static_cast<int>(customers.size()); process.customersSeen++)
+    {
+        const Customer *customer = customers[process.customersSeen]; // Indexed by id
+        if (matchesType(customer, process.customerType) && customer->canMakeOrder())
+            process.customerIds.push_back(customer->getId());
+    }
+}
+
+void DemandGenerator::generate(WareHouse &wareHouse)
+{
+    for (ArrivalProcess &process : processes)
+    {
+        if (process.model == ArrivalModel::ON_OFF)
+        {
+            // Leaving a state each tick with 1 / its mean length keeps the lengths geometric
+            if (uniform() * (process.on ? process.onTicks : process.offTicks) < 1)
+                process.on = !process.on;
+            if (!process.on)
+                continue;
+        }
+        long long arrivals = poisson(process.rate);
+        process.arrived += arrivals;
+        if (arrivals == 0)
+            continue;
+
+        refresh(process, wareHouse);
+        vector<int> &customerIds = process.customerIds;
+        for (long long i = 0; i < arrivals && !customerIds.empty();)
+        {
+            size_t index = random() % customerIds.size();
+            Customer *customer = wareHouse.getCustomers()[customerIds[index]];
+            if (customer->canMakeOrder() && wareHouse.placeOrder(*customer))
+            {
+                process.placed++;
+                i++;
+            }
+            else
+            {
+                // At its limit for good: orders are never taken back
+                customerIds[index] = customerIds.back();
+                customerIds.pop_back();
+            }
+        }
+    }
+}
+
+void DemandGenerator::appendReport(string &buffer) const
+{
+    if (processes.empty())
+    {
+        appendText(buffer, "Demand is off\n");
+        return;
+    }
+    appendText(buffer, "Seed: ");
+    appendInt(buffer, static_cast<long long>(seed));
+    buffer += '\n';
+    for (const ArrivalProcess &process : processes)
+    {
+        appendText(buffer, process.name);
+        if (process.model == ArrivalModel::ON_OFF)
+            appendText(buffer, process.on ? " (on)" : " (off)");
+        appendText(buffer, ": Arrived: ");
+        appendInt(buffer, process.arrived);
+        appendText(buffer, ", Placed: ");
+        appendInt(buffer, process.placed);
+        appendText(buffer, ", Dropped: ");
+        appendInt(buffer, process.arrived - process.placed);
+        buffer += '\n';
+    }
+}
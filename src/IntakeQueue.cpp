@@ -0,0 +1,73 @@
+#include "../include/IntakeQueue.h"
+#include <algorithm>
+
+// Producer implementation
+
+IntakeQueue::Producer::Producer(IntakeQueue &queue, int id) : queue(&queue), id(id), nextSequence(0) {}
+
+void IntakeQueue::Producer::submitOrder(int customerId)
+{
+    IntakeRequest request = {IntakeKind::ORDER, false, id, nextSequence++, customerId, 0, 0, 0};
+    queue->push(request);
+}
+
+void IntakeQueue::Producer::submitCustomer(const string &name, const string &customerType, int distance, int maxOrders)
+{
+    IntakeRequest request = {IntakeKind::CUSTOMER, customerType == "soldier", id, nextSequence++, -1, NameTable::intern(name), distance, maxOrders};
+    queue->push(request);
+}
+
+int IntakeQueue::Producer::getId() const
+{
+    return id;
+}
+
+// IntakeQueue implementation
+
+IntakeQueue::IntakeQueue() : head(nullptr), producerCounter(0) {}
+
+IntakeQueue::~IntakeQueue()
+{
+    Node *node = head.exchange(nullptr);
+    while (node != nullptr)
+    {
+        Node *next = node->next;
+        delete node;
+        node = next;
+    }
+}
+
+IntakeQueue::Producer IntakeQueue::makeProducer()
+{
+    return Producer(*this, producerCounter.fetch_add(1));
+}
+
+void IntakeQueue::push(const IntakeRequest &request)
+{
+    Node *node = new Node{request, head.load(std::memory_order_relaxed)};
+    while (!head.compare_exchange_weak(node->next, node, std::memory_order_release, std::memory_order_relaxed))
+    {
+        // node->next was refreshed with the current head, retry
+    }
+}
+
+size_t IntakeQueue::drain(vector<IntakeRequest> &batch)
+{
+    batch.clear();
+    Node *node = head.exchange(nullptr, std::memory_order_acquire);
+    while (node != nullptr)
+    {
+        batch.push_back(node->request);
+        Node *next = node->next;
+        delete node;
+        node = next;
+    }
+    std::sort(batch.begin(), batch.end(), [](const IntakeRequest &a, const IntakeRequest &b)
+              { return a.producerId != b.producerId ? a.producerId < b.producerId : a.sequence < b.sequence; });
+    return batch.size();
+}
+
+bool IntakeQueue::empty() const
+{
+    return head.load(std::memory_order_relaxed) == nullptr;
+}
@@ -0,0 +1,54 @@
+#include "../include/NameTable.h"
+#include <pthread.h>
+
+NameTable::NameTable() : lock(), names(), index()
+{
+    // Another thread may hold the lock when a background save forks; without this
+    // the child would inherit it locked
+    pthread_atfork(lockForFork, unlockAfterFork, unlockAfterFork);
+}
+
+void NameTable::lockForFork()
+{
+    instance().lock.lock();
+}
+
+void NameTable::unlockAfterFork()
+{
+    instance().lock.unlock();
+}
+
+NameTable &NameTable::instance()
+{
+    static NameTable table;
+    return table;
+}
+
+NameId NameTable::intern(const string &name)
+{
+    NameTable &table = instance();
+    std::lock_guard<std::mutex> guard(table.lock);
+    auto found = table.index.find(name);
+    if (found != table.index.end())
+    {
+        return found->second;
+    }
+    NameId id = static_cast<NameId>(table.names.size());
+    table.names.push_back(name);
+    table.index.emplace(table.names.back(), id);
+    return id;
+}
+
+const string &NameTable::lookup(NameId id)
+{
+    NameTable &table = instance();
+    std::lock_guard<std::mutex> guard(table.lock);
+    return table.names.at(id);
+}
+
+size_t NameTable::size()
+{
+    NameTable &table = instance();
+    std::lock_guard<std::mutex> guard(table.lock);
+    return table.names.size();
+}
@@ -0,0 +1,517 @@
+#include "../include/Network.h"
+#include "../include/WareHouse.h"
+#include "../include/Action.h"
+#include "../include/Volunteer.h"
+#include "../include/OutputSink.h"
+#include "../include/Format.h"
+
+#include <iostream>
+#include <sstream>
+
+WareHouseNetwork::WareHouseNetwork(const vector<string> &configFilePaths)
+    : depots(), rebalancing(true), ticks(0), mutex(), tickStarted(), tickDone(), generation(0), running(0), stopping(false)
+{
+    for (const string &configFilePath : configFilePaths)
+    {
+        depots.emplace_back(new NetworkDepot{configFilePath, std::unique_ptr<WareHouse>(new WareHouse(configFilePath)),
+                                             nullptr, std::thread(), 0, 0, 0, 0});
+        depots.back()->wareHouse->open();
+    }
+    // Every warehouse is read before a thread starts, a bad file leaves none behind
+    for (std::unique_ptr<NetworkDepot> &depot : depots)
+    {
+        depot->thread = std::thread(&WareHouseNetwork::runDepot, this, std::ref(*depot));
+    }
+}
+
+WareHouseNetwork::~WareHouseNetwork()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    tickStarted.notify_all();
+    for (std::unique_ptr<NetworkDepot> &depot : depots)
+    {
+        depot->thread.join();
+    }
+}
+
+void WareHouseNetwork::runDepot(NetworkDepot &depot)
+{
+    uint64_t stepped = 0;
+    std::unique_lock<std::mutex> lock(mutex);
+    while (true)
+    {
+        tickStarted.wait(lock, [&]
+                         { return stopping || generation != stepped; });
+        if (stopping)
+            return;
+        stepped = generation;
+        lock.unlock();
+        depot.wareHouse->simulateStep(1);
+        lock.lock();
+        if (--running == 0)
+            tickDone.notify_one();
+    }
+}
+
+void WareHouseNetwork::step(int numberOfSteps)
+{
+    for (int i = 0; i < numberOfSteps; i++)
+    {
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            running = depots.size();
+            generation++;
+            tickStarted.notify_all();
+            tickDone.wait(lock, [&]
+                          { return running == 0; });
+        }
+        ticks++;
+        if (rebalancing)
+            rebalance();
+    }
+}
+
+// The stand-in keeping the slot of a volunteer that left
+static bool isVacant(const Volunteer *volunteer)
+{
+    const DriverVolunteer *driver = dynamic_cast<const DriverVolunteer *>(volunteer);
+    return driver != nullptr && driver->getMaxDistance() == NETWORK_VACANT_REACH && driver->getName() == NETWORK_VACANT_NAME;
+}
+
+// Ticks until an order at this distance would be delivered, -1 if no volunteer can handle it
+static long long expectedTicks(const WareHouse &wareHouse, int distance)
+{
+    long long collectors = 0;
+    long long coolDowns = 0;
+    long long drivers = 0;
+    long long speeds = 0;
+    for (const Volunteer *volunteer : wareHouse.getVolunteers())
+    {
+        if (!volunteer->hasOrdersLeft())
+            continue;
+        const CollectorVolunteer *collector = dynamic_cast<const CollectorVolunteer *>(volunteer);
+        const DriverVolunteer *driver = dynamic_cast<const DriverVolunteer *>(volunteer);
+        if (collector != nullptr)
+        {
+            collectors++;
+            coolDowns += collector->getCoolDown();
+        }
+        else if (driver != nullptr && driver->getMaxDistance() >= distance && driver->getDistancePerStep() > 0)
+        {
+            drivers++;
+            speeds += driver->getDistancePerStep();
+        }
+    }
+    if (collectors == 0 || drivers == 0)
+        return -1;
+
+    // The orders ahead in each queue and this one, in rounds shared out among the volunteers
+    // of the role; a round takes the mean cooldown or the trip at the mean speed
+    const WareHouseSummary &summary = wareHouse.getSummary();
+    long long collectRounds = (summary.pendingOrders + collectors) / collectors;
+    long long deliverRounds = (summary.pendingOrders + summary.collectingOrders + drivers) / drivers;
+    long long trip = std::max(1LL, (distance * drivers + speeds - 1) / speeds);
+    return collectRounds * coolDowns / collectors + deliverRounds * trip;
+}
+
+int WareHouseNetwork::route(int home, int customerId)
+{
+    WareHouse &homeWareHouse = *depots[home]->wareHouse;
+    int target = home;
+    int targetCustomerId = customerId;
+    if (customerId >= 0 && customerId < homeWareHouse.getCustomerCounter())
+    {
+        const NameId name = homeWareHouse.getCustomers()[customerId]->getNameId(); // Indexed by id
+        long long best = -1;
+        // From the home depot on, so ties stay there
+        for (size_t i = 0; i < depots.size(); i++)
+        {
+            int index = static_cast<int>((home + i) % depots.size());
+            const WareHouse &wareHouse = *depots[index]->wareHouse;
+            for (const Customer *customer : wareHouse.getCustomers())
+            {
+                if (customer->getNameId() != name || !customer->canMakeOrder())
+                    continue;
+                long long expected = expectedTicks(wareHouse, customer->getCustomerDistance());
+                if (expected >= 0 && (best < 0 || expected < best))
+                {
+                    best = expected;
+                    target = index;
+                    targetCustomerId = customer->getId();
+                }
+                break;
+            }
+        }
+    }
+
+    // Placed the way the order command places it; an order nobody can take stays home and fails there
+    NetworkDepot &depot = *depots[target];
+    int orderCounter = depot.wareHouse->getOrderCounter();
+    AddOrder action(targetCustomerId);
+    action.act(*depot.wareHouse);
+    if (depot.wareHouse->getOrderCounter() == orderCounter)
+        return -1;
+    if (target != home)
+    {
+        depots[home]->routedOut++;
+        depot.routedIn++;
+    }
+    return target;
+}
+
+bool WareHouseNetwork::moveVolunteer(NetworkDepot &from, size_t index, NetworkDepot &to)
+{
+    WareHouse &source = *from.wareHouse;
+    WareHouse &target = *to.wareHouse;
+    const VolunteerList &targetVolunteers = target.getVolunteers();
+
+    // A vacant slot first, else the end while the ids still match the slots
+    size_t slot = 0;
+    while (slot < targetVolunteers.size() && !isVacant(targetVolunteers[slot]))
+    {
+        slot++;
+    }
+    if (slot == targetVolunteers.size() && static_cast<int>(slot) != target.getVolunteerCounter())
+        return false;
+
+    const Volunteer *volunteer = source.getVolunteers()[index];
+    const CollectorVolunteer *collector = dynamic_cast<const CollectorVolunteer *>(volunteer);
+    const DriverVolunteer *driver = dynamic_cast<const DriverVolunteer *>(volunteer);
+    vector<string> line = {"volunteer", volunteer->getName()};
+    if (collector != nullptr)
+    {
+        line.insert(line.end(), {"collector", std::to_string(collector->getCoolDown())});
+        if (collector->getWaveSize() > 1)
+            line.insert(line.end(), {"wave", std::to_string(collector->getWaveSize())});
+    }
+    else
+    {
+        line.insert(line.end(), {"driver", std::to_string(driver->getMaxDistance()), std::to_string(driver->getDistancePerStep())});
+    }
+    source.replaceVolunteer(index, DriverVolunteer(volunteer->getId(), NETWORK_VACANT_NAME, NETWORK_VACANT_REACH, 1));
+
+    if (slot == targetVolunteers.size())
+    {
+        target.addVolunteer(line);
+    }
+    else if (line[2] == "collector")
+    {
+        target.replaceVolunteer(slot, CollectorVolunteer(targetVolunteers[slot]->getId(), line[1], std::stoi(line[3]), collector->getWaveSize()));
+    }
+    else
+    {
+        target.replaceVolunteer(slot, DriverVolunteer(targetVolunteers[slot]->getId(), line[1], std::stoi(line[3]), std::stoi(line[4])));
+    }
+    from.volunteersOut++;
+    to.volunteersIn++;
+    return true;
+}
+
+int WareHouseNetwork::rebalance()
+{
+    int moved = 0;
+    for (bool collectors : {true, false})
+    {
+        // Per depot: orders waiting for the role, its idle volunteers and the ones free to leave
+        vector<int> waiting(depots.size(), 0);
+        vector<int> idle(depots.size(), 0);
+        vector<int> nearest(depots.size(), -1); // Distance of the nearest collected order waiting
+        vector<vector<size_t>> movable(depots.size());
+        for (size_t i = 0; i < depots.size(); i++)
+        {
+            const WareHouse &wareHouse = *depots[i]->wareHouse;
+            const WareHouseSummary &summary = wareHouse.getSummary();
+            const vector<Order *> &pendingOrders = wareHouse.getPendingOrders();
+            // The pending queue holds the orders waiting for a collector and those waiting for a driver
+            waiting[i] = collectors ? summary.pendingOrders : static_cast<int>(pendingOrders.size()) - summary.pendingOrders;
+            if (!collectors && waiting[i] > 0)
+            {
+                for (const Order *order : pendingOrders)
+                {
+                    if (order->getStatus() == OrderStatus::COLLECTING && (nearest[i] < 0 || order->getDistance() < nearest[i]))
+                        nearest[i] = order->getDistance();
+                }
+            }
+            const VolunteerList &volunteers = wareHouse.getVolunteers();
+            for (size_t j = 0; j < volunteers.size(); j++)
+            {
+                const Volunteer *volunteer = volunteers[j];
+                bool isCollector = dynamic_cast<const CollectorVolunteer *>(volunteer) != nullptr;
+                if (isCollector != collectors || isVacant(volunteer) || volunteer->isBusy() || !volunteer->hasOrdersLeft())
+                    continue;
+                idle[i]++;
+                bool limited = dynamic_cast<const LimitedCollectorVolunteer *>(volunteer) != nullptr ||
+                               dynamic_cast<const LimitedDriverVolunteer *>(volunteer) != nullptr;
+                if (!limited)
+                    movable[i].push_back(j);
+            }
+        }
+
+        for (size_t to = 0; to < depots.size(); to++)
+        {
+            for (size_t from = 0; from < depots.size() && waiting[to] > idle[to]; from++)
+            {
+                if (waiting[from] > 0)
+                    continue;
+                // Keep one behind for the next order there
+                while (waiting[to] > idle[to] && idle[from] > 1 && !movable[from].empty())
+                {
+                    size_t index = movable[from].back();
+                    movable[from].pop_back();
+                    const DriverVolunteer *driver = dynamic_cast<const DriverVolunteer *>(depots[from]->wareHouse->getVolunteers()[index]);
+                    if (driver != nullptr && driver->getMaxDistance() < nearest[to])
+                        continue;
+                    if (!moveVolunteer(*depots[from], index, *depots[to]))
+                        break;
+                    idle[from]--;
+                    idle[to]++;
+                    moved++;
+                }
+            }
+        }
+    }
+    return moved;
+}
+
+bool WareHouseNetwork::executeAt(NetworkDepot &depot, const string &userInput)
+{
+    // The warehouse actions keep the backup in the global one
+    WareHouse *saved = backup;
+    backup = depot.backup.release();
+    bool parsed = depot.wareHouse->execute(userInput);
+    depot.backup.reset(backup);
+    backup = saved;
+    return parsed;
+}
+
+// numerator / denominator with two decimals
+static void appendRatio(string &buffer, long long numerator, long long denominator)
+{
+    long long hundredths = denominator == 0 ? 0 : numerator * 100 / denominator;
+    appendInt(buffer, hundredths / 100);
+    buffer += '.';
+    if (hundredths % 100 < 10)
+        buffer += '0';
+    appendInt(buffer, hundredths % 100);
+}
+
+void WareHouseNetwork::appendSummary(string &buffer) const
+{
+    WareHouseSummary total = {0, 0, 0, 0, 0, 0};
+    long long volunteers = 0;
+    long long vacant = 0;
+    long long routed = 0;
+    long long moved = 0;
+    TickCounts window = {0, 0, 0, 0, 0};
+    appendText(buffer, "Network: ");
+    appendInt(buffer, depots.size());
+    appendText(buffer, " depots, Tick: ");
+    appendInt(buffer, ticks);
+    appendText(buffer, rebalancing ? ", Rebalancing on\n" : ", Rebalancing off\n");
+    for (size_t i = 0; i < depots.size(); i++)
+    {
+        const NetworkDepot &depot = *depots[i];
+        const WareHouse &wareHouse = *depot.wareHouse;
+        const WareHouseSummary &summary = wareHouse.getSummary();
+        int depotVacant = 0;
+        for (const Volunteer *volunteer : wareHouse.getVolunteers())
+        {
+            if (isVacant(volunteer))
+                depotVacant++;
+        }
+        int depotVolunteers = static_cast<int>(wareHouse.getVolunteers().size()) - depotVacant;
+
+        appendText(buffer, "Depot ");
+        appendInt(buffer, i);
+        appendText(buffer, " (");
+        appendText(buffer, depot.configFilePath);
+        appendText(buffer, "): Orders: pending ");
+        appendInt(buffer, summary.pendingOrders);
+        appendText(buffer, ", collecting ");
+        appendInt(buffer, summary.collectingOrders);
+        appendText(buffer, ", delivering ");
+        appendInt(buffer, summary.deliveringOrders);
+        appendText(buffer, ", completed ");
+        appendInt(buffer, summary.completedOrders);
+        appendText(buffer, "; Volunteers: ");
+        appendInt(buffer, depotVolunteers);
+        appendText(buffer, ", busy ");
+        appendInt(buffer, summary.busyVolunteers);
+        appendText(buffer, ", vacant slots ");
+        appendInt(buffer, depotVacant);
+        appendText(buffer, "; Routed in ");
+        appendInt(buffer, depot.routedIn);
+        appendText(buffer, ", out ");
+        appendInt(buffer, depot.routedOut);
+        appendText(buffer, "; Volunteers in ");
+        appendInt(buffer, depot.volunteersIn);
+        appendText(buffer, ", out ");
+        appendInt(buffer, depot.volunteersOut);
+        buffer += '\n';
+
+        total.pendingOrders += summary.pendingOrders;
+        total.collectingOrders += summary.collectingOrders;
+        total.deliveringOrders += summary.deliveringOrders;
+        total.completedOrders += summary.completedOrders;
+        total.busyVolunteers += summary.busyVolunteers;
+        volunteers += depotVolunteers;
+        vacant += depotVacant;
+        routed += depot.routedIn;
+        moved += depot.volunteersIn;
+        const TickCounts &counts = wareHouse.getThroughput().getWindow(1);
+        window.created += counts.created;
+        window.delivered += counts.delivered;
+        window.busyVolunteers += counts.busyVolunteers;
+        window.volunteers += counts.volunteers;
+    }
+
+    appendText(buffer, "Total: Orders: pending ");
+    appendInt(buffer, total.pendingOrders);
+    appendText(buffer, ", collecting ");
+    appendInt(buffer, total.collectingOrders);
+    appendText(buffer, ", delivering ");
+    appendInt(buffer, total.deliveringOrders);
+    appendText(buffer, ", completed ");
+    appendInt(buffer, total.completedOrders);
+    appendText(buffer, "; Volunteers: ");
+    appendInt(buffer, volunteers);
+    appendText(buffer, ", busy ");
+    appendInt(buffer, total.busyVolunteers);
+    appendText(buffer, ", vacant slots ");
+    appendInt(buffer, vacant);
+    appendText(buffer, "; Routed ");
+    appendInt(buffer, routed);
+    appendText(buffer, "; Volunteers moved ");
+    appendInt(buffer, moved);
+    buffer += '\n';
+
+    // The depots step together, so their windows cover the same ticks
+    int windowTicks = depots.empty() ? 0 : depots[0]->wareHouse->getThroughput().getWindowTicks(1);
+    appendText(buffer, "Last ");
+    appendInt(buffer, ThroughputMeter::windowSizes[1]);
+    appendText(buffer, " ticks: Created: ");
+    appendRatio(buffer, window.created, windowTicks);
+    appendText(buffer, "/tick, Delivered: ");
+    appendRatio(buffer, window.delivered, windowTicks);
+    appendText(buffer, "/tick, Utilization: ");
+    appendRatio(buffer, window.busyVolunteers * 100, window.volunteers);
+    appendText(buffer, "%\n");
+}
+
+bool WareHouseNetwork::execute(const string &userInput)
+{
+    std::istringstream arguments(userInput);
+    string command;
+    arguments >> command;
+    int depot = -1;
+    string report;
+    if (command == "order")
+    {
+        // "order <depot> <customer_id>", the customer as the depot knows them
+        int customerId = -1;
+        if (!(arguments >> depot >> customerId) || depot < 0 || depot >= static_cast<int>(depots.size()))
+        {
+            report = "Invalid order: " + userInput + "\n";
+        }
+        else
+        {
+            int target = route(depot, customerId);
+            if (target >= 0)
+            {
+                appendText(report, "Order ");
+                appendInt(report, depots[target]->wareHouse->getOrderCounter() - 1);
+                appendText(report, " placed at depot ");
+                appendInt(report, target);
+                report += '\n';
+            }
+        }
+    }
+    else if (command == "step")
+    {
+        int numberOfSteps = -1;
+        if (!(arguments >> numberOfSteps) || numberOfSteps < 0)
+            report = "Invalid step: " + userInput + "\n";
+        else
+            step(numberOfSteps);
+    }
+    else if (command == "summary")
+    {
+        appendSummary(report);
+    }
+    else if (command == "rebalance")
+    {
+        // "rebalance on", "rebalance off" after every tick, or "rebalance" once now
+        string argument;
+        arguments >> argument;
+        if (argument == "on" || argument == "off")
+        {
+            rebalancing = argument == "on";
+        }
+        else
+        {
+            appendText(report, "Volunteers moved: ");
+            appendInt(report, rebalance());
+            report += '\n';
+        }
+    }
+    else if (command == "depot")
+    {
+        // "depot <depot> <command>" runs a warehouse command there, as in a single warehouse
+        string depotCommand;
+        if (!(arguments >> depot) || depot < 0 || depot >= static_cast<int>(depots.size()))
+        {
+            report = "Invalid depot: " + userInput + "\n";
+        }
+        else
+        {
+            std::getline(arguments >> std::ws, depotCommand);
+            if (depotCommand == "close" || depotCommand.substr(0, 4) == "step")
+                report = "Not for one depot: " + depotCommand + "\n";
+            else
+                executeAt(*depots[depot], depotCommand);
+        }
+    }
+    else if (userInput == "backup" || userInput == "restore")
+    {
+        for (std::unique_ptr<NetworkDepot> &each : depots)
+        {
+            executeAt(*each, userInput);
+        }
+    }
+    else if (userInput == "close")
+    {
+        // Every depot closes, its orders under its number
+        for (size_t i = 0; i < depots.size(); i++)
+        {
+            string header = "Depot ";
+            appendInt(header, i);
+            header += ":\n";
+            output << header;
+            executeAt(*depots[i], userInput);
+        }
+        return false;
+    }
+    else
+    {
+        report = "Invalid action!\n";
+    }
+    output << report;
+    return true;
+}
+
+void WareHouseNetwork::start()
+{
+    std::cout << "Network of " << depots.size() << " warehouses is open!" << std::endl;
+    string userInput;
+    while (true)
+    {
+        output.flush();
+        std::cout << "Enter an action: " << std::flush;
+        if (!std::getline(std::cin, userInput) || !execute(userInput))
+            break;
+    }
+    output.flush();
+}
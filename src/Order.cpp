@@ -1,9 +1,10 @@
 #include "../include/Order.h"
+#include "../include/Format.h"
 
 // Constructor for the Order class
 Order::Order(int id, int customerId, int distance)
-    : id(id), customerId(customerId), distance(distance),
-      status(OrderStatus::PENDING), collectorId(NO_VOLUNTEER), driverId(NO_VOLUNTEER) {}
+    : id(id), customerId(customerId), collectorId(NO_VOLUNTEER), driverId(NO_VOLUNTEER),
+      distance(distance), status(OrderStatus::PENDING) {}
 
 // Getter methods
 int Order::getId() const
@@ -55,16 +56,28 @@ void Order::setDriverId(int newDriverId)
 // String representation of the Order
 const string Order::toString() const
 {
-    string statusString = getStatusString(status);
-    return "Order ID: " + std::to_string(id) +
-           "\nCustomer ID: " + std::to_string(customerId) +
-           "\nDistance: " + std::to_string(distance) +
-           "\nStatus: " + statusString +
-           "\nCollector ID: " + std::to_string(collectorId) +
-           "\nDriver ID: " + std::to_string(driverId);
+    string buffer;
+    appendTo(buffer);
+    return buffer;
 }
 
-const string Order::getStatusString(enum OrderStatus sta) const
+void Order::appendTo(string &buffer) const
+{
+    appendText(buffer, "Order ID: ");
+    appendInt(buffer, id);
+    appendText(buffer, "\nCustomer ID: ");
+    appendInt(buffer, customerId);
+    appendText(buffer, "\nDistance: ");
+    appendInt(buffer, distance);
+    appendText(buffer, "\nStatus: ");
+    appendText(buffer, getStatusString(status));
+    appendText(buffer, "\nCollector ID: ");
+    appendInt(buffer, collectorId);
+    appendText(buffer, "\nDriver ID: ");
+    appendInt(buffer, driverId);
+}
+
+std::string_view Order::getStatusString(enum OrderStatus sta)
 {
     switch (sta)
     {
@@ -0,0 +1,241 @@
+#include "../include/OrderArchive.h"
+#include <algorithm>
+
+OrderArchive::Block::Block() : rows(0), minId(0), maxId(0), runningMaxId(0), firstId(0), firstTick(0), base(), width(), bits() {}
+
+OrderArchive::OrderArchive() : sealed(), open(), rows(0) {}
+
+// The value of a column (in OrderArchive::Column order) in a row, before the base is subtracted
+static int64_t columnValue(const ArchivedOrder *rows, int row, int column)
+{
+    const ArchivedOrder &order = rows[row];
+    switch (column)
+    {
+    case 0:
+        return row == 0 ? 0 : static_cast<int64_t>(order.id) - rows[row - 1].id;
+    case 1:
+        return order.customerId;
+    case 2:
+        return order.distance;
+    case 3:
+        return order.collectorId;
+    case 4:
+        return order.driverId;
+    default:
+        return row == 0 ? 0 : static_cast<int64_t>(order.completedTick) - rows[row - 1].completedTick;
+    }
+}
+
+static uint64_t getBits(const vector<uint64_t> &bits, size_t position, int width)
+{
+    if (width == 0)
+    {
+        return 0;
+    }
+    size_t word = position / 64;
+    int shift = static_cast<int>(position % 64);
+    uint64_t value = bits[word] >> shift;
+    if (shift + width > 64)
+    {
+        value |= bits[word + 1] << (64 - shift);
+    }
+    return value & ((uint64_t(1) << width) - 1);
+}
+
+static void putBits(vector<uint64_t> &bits, size_t position, int width, uint64_t value)
+{
+    if (width == 0)
+    {
+        return;
+    }
+    size_t word = position / 64;
+    int shift = static_cast<int>(position % 64);
+    bits[word] |= value << shift;
+    if (shift + width > 64)
+    {
+        bits[word + 1] |= value >> (64 - shift);
+    }
+}
+
+void OrderArchive::seal(const vector<ArchivedOrder> &rows, Block &block)
+{
+    block.rows = static_cast<int>(rows.size());
+    block.firstId = rows.front().id;
+    block.firstTick = rows.front().completedTick;
+    block.minId = rows.front().id;
+    block.maxId = rows.front().id;
+    for (const ArchivedOrder &order : rows)
+    {
+        block.minId = std::min(block.minId, order.id);
+        block.maxId = std::max(block.maxId, order.id);
+    }
+
+    // Frame of reference: each column stores value - min in as few bits as its range needs
+    size_t totalBits = 0;
+    for (int c = 0; c < NUM_COLUMNS; c++)
+    {
+        int64_t low = columnValue(rows.data(), 0, c);
+        int64_t high = low;
+        for (int r = 1; r < block.rows; r++)
+        {
+            int64_t value = columnValue(rows.data(), r, c);
+            low = std::min(low, value);
+            high = std::max(high, value);
+        }
+        block.base[c] = low;
+        uint64_t range = static_cast<uint64_t>(high - low);
+        int width = 0;
+        while (width < 64 && (range >> width) != 0)
+        {
+            width++;
+        }
+        block.width[c] = static_cast<uint8_t>(width);
+        totalBits += static_cast<size_t>(width) * block.rows;
+    }
+
+    block.bits.assign((totalBits + 63) / 64, 0);
+    size_t position = 0;
+    for (int c = 0; c < NUM_COLUMNS; c++)
+    {
+        for (int r = 0; r < block.rows; r++)
+        {
+            putBits(block.bits, position, block.width[c], static_cast<uint64_t>(columnValue(rows.data(), r, c) - block.base[c]));
+            position += block.width[c];
+        }
+    }
+}
+
+void OrderArchive::append(const Order &order, int completedTick)
+{
+    if (open.empty())
+    {
+        open.reserve(ARCHIVE_BLOCK_SIZE);
+    }
+    open.push_back(ArchivedOrder{order.getId(), order.getCustomerId(), order.getDistance(), order.getCollectorId(), order.getDriverId(), completedTick});
+    rows++;
+
+    // Seal a full block; from now on it is shared, never written again
+    if (open.size() == ARCHIVE_BLOCK_SIZE)
+    {
+        std::shared_ptr<Block> block = std::make_shared<Block>();
+        seal(open, *block);
+        block->runningMaxId = sealed.empty() ? block->maxId : std::max(block->maxId, sealed.back()->runningMaxId);
+        sealed.push_back(block);
+        open.clear();
+    }
+}
+
+void OrderArchive::decodeRow(const Block &block, int row, int &prevId, int &prevTick, ArchivedOrder &result)
+{
+    int64_t values[NUM_COLUMNS];
+    size_t columnStart = 0;
+    for (int c = 0; c < NUM_COLUMNS; c++)
+    {
+        size_t position = columnStart + static_cast<size_t>(row) * block.width[c];
+        values[c] = block.base[c] + static_cast<int64_t>(getBits(block.bits, position, block.width[c]));
+        columnStart += static_cast<size_t>(block.rows) * block.width[c];
+    }
+    result.id = row == 0 ? block.firstId : static_cast<int>(prevId + values[ID]);
+    result.customerId = static_cast<int>(values[CUSTOMER]);
+    result.distance = static_cast<int>(values[DISTANCE]);
+    result.collectorId = static_cast<int>(values[COLLECTOR]);
+    result.driverId = static_cast<int>(values[DRIVER]);
+    result.completedTick = row == 0 ? block.firstTick : static_cast<int>(prevTick + values[TICK]);
+    prevId = result.id;
+    prevTick = result.completedTick;
+}
+
+int OrderArchive::blockRows(size_t index) const
+{
+    return index < sealed.size() ? sealed[index]->rows : static_cast<int>(open.size());
+}
+
+void OrderArchive::readRow(size_t blockIndex, int row, int &prevId, int &prevTick, ArchivedOrder &result) const
+{
+    if (blockIndex < sealed.size())
+    {
+        decodeRow(*sealed[blockIndex], row, prevId, prevTick, result);
+    }
+    else
+    {
+        result = open[row];
+    }
+}
+
+bool OrderArchive::find(int orderId, ArchivedOrder &result) const
+{
+    // Every block before the first whose running maximum reaches the id ends below it.
+    // Out-of-order completions widen a block's range, so the scan goes on past a block
+    // that does not hold the id; ids are unique, it stops at the one that does
+    auto first = std::lower_bound(sealed.begin(), sealed.end(), orderId, [](const std::shared_ptr<const Block> &block, int id)
+                                  { return block->runningMaxId < id; });
+    for (auto block = first; block != sealed.end(); ++block)
+    {
+        if (orderId < (*block)->minId || orderId > (*block)->maxId)
+        {
+            continue;
+        }
+        int prevId = 0;
+        int prevTick = 0;
+        for (int i = 0; i < (*block)->rows; i++)
+        {
+            decodeRow(**block, i, prevId, prevTick, result);
+            if (result.id == orderId)
+            {
+                return true;
+            }
+        }
+    }
+    for (const ArchivedOrder &order : open)
+    {
+        if (order.id == orderId)
+        {
+            result = order;
+            return true;
+        }
+    }
+    return false;
+}
+
+int OrderArchive::size() const
+{
+    return rows;
+}
+
+size_t OrderArchive::blockMemory(const Block &block)
+{
+    return sizeof(Block) + block.bits.capacity() * sizeof(uint64_t);
+}
+
+size_t OrderArchive::memoryUsage() const
+{
+    size_t bytes = sealed.capacity() * sizeof(std::shared_ptr<const Block>) + open.capacity() * sizeof(ArchivedOrder);
+    for (const auto &block : sealed)
+    {
+        bytes += blockMemory(*block);
+    }
+    return bytes;
+}
+
+// Cursor implementation
+
+OrderArchive::Cursor::Cursor(const OrderArchive &archive) : archive(archive), blockIndex(0), rowInBlock(0), prevId(0), prevTick(0) {}
+
+bool OrderArchive::Cursor::next(ArchivedOrder &result)
+{
+    while (blockIndex <= archive.sealed.size() && rowInBlock >= archive.blockRows(blockIndex))
+    {
+        // Move on to the next block, deltas restart there
+        blockIndex++;
+        rowInBlock = 0;
+        prevId = 0;
+        prevTick = 0;
+    }
+    if (blockIndex > archive.sealed.size())
+    {
+        return false;
+    }
+    archive.readRow(blockIndex, rowInBlock, prevId, prevTick, result);
+    rowInBlock++;
+    return true;
+}
@@ -0,0 +1,195 @@
+#include "../include/OrderTable.h"
+#include <algorithm>
+#include <stdexcept>
+
+// Free slots hold a placeholder order; only the live bit says whether a slot is used
+OrderTable::Chunk::Chunk() : orders(ORDER_CHUNK_SIZE, Order(-1, -1, 0)), live(), liveCount(0) {}
+
+OrderTable::OrderTable() : chunks(), firstChunk(0), liveOrders(0), endId(0) {}
+
+OrderTable::OrderTable(const OrderTable &other) : chunks(), firstChunk(other.firstChunk), liveOrders(other.liveOrders), endId(other.endId)
+{
+    for (const std::unique_ptr<Chunk> &chunk : other.chunks)
+    {
+        chunks.push_back(chunk == nullptr ? nullptr : std::make_unique<Chunk>(*chunk));
+    }
+}
+
+OrderTable &OrderTable::operator=(const OrderTable &other)
+{
+    if (this == &other)
+    {
+        return *this;
+    }
+    // Overwrite the chunks already allocated, and only allocate what is missing
+    vector<std::unique_ptr<Chunk>> spare;
+    for (std::unique_ptr<Chunk> &chunk : chunks)
+    {
+        if (chunk != nullptr)
+            spare.push_back(std::move(chunk));
+    }
+    chunks.clear();
+    for (const std::unique_ptr<Chunk> &chunk : other.chunks)
+    {
+        if (chunk == nullptr)
+        {
+            chunks.push_back(nullptr);
+        }
+        else if (spare.empty())
+        {
+            chunks.push_back(std::make_unique<Chunk>(*chunk));
+        }
+        else
+        {
+            *spare.back() = *chunk;
+            chunks.push_back(std::move(spare.back()));
+            spare.pop_back();
+        }
+    }
+    firstChunk = other.firstChunk;
+    liveOrders = other.liveOrders;
+    endId = other.endId;
+    return *this;
+}
+
+OrderTable::Chunk *OrderTable::chunkOf(int orderId) const
+{
+    if (orderId < 0)
+    {
+        return nullptr;
+    }
+    int index = orderId / ORDER_CHUNK_SIZE - firstChunk;
+    if (index < 0 || index >= static_cast<int>(chunks.size()))
+    {
+        return nullptr;
+    }
+    return chunks[index].get();
+}
+
+Order &OrderTable::store(const Order &order)
+{
+    int number = order.getId() / ORDER_CHUNK_SIZE;
+    if (chunks.empty())
+    {
+        firstChunk = number;
+    }
+    while (number < firstChunk)
+    {
+        chunks.push_front(nullptr);
+        firstChunk--;
+    }
+    while (number >= firstChunk + static_cast<int>(chunks.size()))
+    {
+        chunks.push_back(nullptr);
+    }
+    std::unique_ptr<Chunk> &chunk = chunks[number - firstChunk];
+    if (chunk == nullptr)
+    {
+        chunk = std::make_unique<Chunk>();
+    }
+    int slot = order.getId() % ORDER_CHUNK_SIZE;
+    if (!chunk->live[slot])
+    {
+        chunk->live[slot] = true;
+        chunk->liveCount++;
+        liveOrders++;
+    }
+    chunk->orders[slot] = order;
+    return chunk->orders[slot];
+}
+
+Order &OrderTable::add(const Order &order)
+{
+    if (order.getId() < endId)
+    {
+        throw std::invalid_argument("Order ID already used: " + std::to_string(order.getId()));
+    }
+    endId = order.getId() + 1;
+    return store(order);
+}
+
+Order &OrderTable::put(const Order &order)
+{
+    if (order.getId() < 0)
+    {
+        throw std::invalid_argument("Invalid order ID: " + std::to_string(order.getId()));
+    }
+    endId = std::max(endId, order.getId() + 1);
+    return store(order);
+}
+
+Order *OrderTable::find(int orderId)
+{
+    Chunk *chunk = chunkOf(orderId);
+    if (chunk == nullptr || !chunk->live[orderId % ORDER_CHUNK_SIZE])
+    {
+        return nullptr;
+    }
+    return &chunk->orders[orderId % ORDER_CHUNK_SIZE];
+}
+
+const Order *OrderTable::find(int orderId) const
+{
+    return const_cast<OrderTable *>(this)->find(orderId);
+}
+
+void OrderTable::retire(int orderId)
+{
+    Chunk *chunk = chunkOf(orderId);
+    int slot = orderId % ORDER_CHUNK_SIZE;
+    if (chunk == nullptr || !chunk->live[slot])
+    {
+        return;
+    }
+    chunk->orders[slot].setStatus(OrderStatus::COMPLETED);
+    chunk->live[slot] = false;
+    liveOrders--;
+    if (--chunk->liveCount == 0)
+    {
+        chunks[orderId / ORDER_CHUNK_SIZE - firstChunk].reset();
+        trim();
+    }
+}
+
+void OrderTable::trim()
+{
+    while (!chunks.empty() && chunks.front() == nullptr)
+    {
+        chunks.pop_front();
+        firstChunk++;
+    }
+    while (!chunks.empty() && chunks.back() == nullptr)
+    {
+        chunks.pop_back();
+    }
+}
+
+int OrderTable::size() const
+{
+    return liveOrders;
+}
+
+void OrderTable::appendLive(vector<Order> &buffer) const
+{
+    for (const std::unique_ptr<Chunk> &chunk : chunks)
+    {
+        if (chunk == nullptr)
+            continue;
+        for (int slot = 0; slot < ORDER_CHUNK_SIZE; slot++)
+        {
+            if (chunk->live[slot])
+                buffer.push_back(chunk->orders[slot]);
+        }
+    }
+}
+
+size_t OrderTable::memoryUsage() const
+{
+    size_t bytes = chunks.size() * sizeof(std::unique_ptr<Chunk>);
+    for (const std::unique_ptr<Chunk> &chunk : chunks)
+    {
+        if (chunk != nullptr)
+            bytes += sizeof(Chunk) + ORDER_CHUNK_SIZE * sizeof(Order);
+    }
+    return bytes;
+}
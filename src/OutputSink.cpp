@@ -0,0 +1,154 @@
+#include "../include/OutputSink.h"
+
+#include <cerrno>
+#include <charconv>
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+
+OutputSink output(STDOUT_FILENO);
+
+OutputSink::OutputSink(int fd) : buffer(OUTPUT_BUFFER_SIZE), used(0), fd(fd), ownedFd(-1), captureTarget(nullptr) {}
+
+OutputSink::~OutputSink()
+{
+    restore();
+    flush();
+}
+
+void OutputSink::append(const char *data, size_t length)
+{
+    if (captureTarget != nullptr)
+    {
+        captureTarget->append(data, length);
+        return;
+    }
+    if (used + length > buffer.size())
+    {
+        flush();
+        // Larger than the whole buffer, write it through
+        if (length > buffer.size())
+        {
+            writeAll(data, length);
+            return;
+        }
+    }
+    std::memcpy(buffer.data() + used, data, length);
+    used += length;
+}
+
+void OutputSink::writeAll(const char *data, size_t length)
+{
+    while (length > 0)
+    {
+        ssize_t written = ::write(fd, data, length);
+        if (written < 0)
+        {
+            if (errno == EINTR)
+                continue;
+            return; // Nothing sensible to report to, drop the output
+        }
+        data += written;
+        length -= static_cast<size_t>(written);
+    }
+}
+
+void OutputSink::flush()
+{
+    writeAll(buffer.data(), used);
+    used = 0;
+}
+
+OutputSink &OutputSink::operator<<(std::string_view text)
+{
+    append(text.data(), text.size());
+    return *this;
+}
+
+OutputSink &OutputSink::operator<<(const char *text)
+{
+    append(text, std::strlen(text));
+    return *this;
+}
+
+OutputSink &OutputSink::operator<<(const string &text)
+{
+    append(text.data(), text.size());
+    return *this;
+}
+
+OutputSink &OutputSink::operator<<(char c)
+{
+    append(&c, 1);
+    return *this;
+}
+
+OutputSink &OutputSink::operator<<(int value)
+{
+    return *this << static_cast<long long>(value);
+}
+
+OutputSink &OutputSink::operator<<(long long value)
+{
+    char digits[24];
+    std::to_chars_result result = std::to_chars(digits, digits + sizeof(digits), value);
+    append(digits, result.ptr - digits);
+    return *this;
+}
+
+OutputSink &OutputSink::operator<<(size_t value)
+{
+    char digits[24];
+    std::to_chars_result result = std::to_chars(digits, digits + sizeof(digits), value);
+    append(digits, result.ptr - digits);
+    return *this;
+}
+
+OutputSink &OutputSink::operator<<(double value)
+{
+    char digits[32];
+    std::to_chars_result result = std::to_chars(digits, digits + sizeof(digits), value, std::chars_format::fixed, 2);
+    append(digits, result.ptr - digits);
+    return *this;
+}
+
+bool OutputSink::redirect(const string &path)
+{
+    int newFd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (newFd < 0)
+    {
+        return false;
+    }
+    restore();
+    fd = newFd;
+    ownedFd = newFd;
+    return true;
+}
+
+void OutputSink::restore()
+{
+    if (ownedFd == -1)
+    {
+        return;
+    }
+    flush();
+    ::close(ownedFd);
+    ownedFd = -1;
+    fd = STDOUT_FILENO;
+}
+
+bool OutputSink::isRedirected() const
+{
+    return ownedFd != -1;
+}
+
+void OutputSink::beginCapture(string &target)
+{
+    flush();
+    captureTarget = &target;
+}
+
+void OutputSink::endCapture()
+{
+    captureTarget = nullptr;
+}
@@ -0,0 +1,768 @@
+#include "../include/Partition.h"
+#include "../include/WareHouse.h"
+#include "../include/Action.h"
+#include "../include/Volunteer.h"
+#include "../include/OutputSink.h"
+#include "../include/Format.h"
+
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <sys/socket.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+PartitionMessage::PartitionMessage() : bytes(), readAt(0) {}
+
+PartitionMessage::PartitionMessage(PartitionRequest request) : bytes(), readAt(0)
+{
+    putInt(static_cast<int32_t>(request));
+}
+
+void PartitionMessage::putInt(int32_t value)
+{
+    bytes.append(reinterpret_cast<const char *>(&value), sizeof(value));
+}
+
+void PartitionMessage::putString(const string &text)
+{
+    putInt(static_cast<int32_t>(text.size()));
+    bytes += text;
+}
+
+int32_t PartitionMessage::getInt()
+{
+    int32_t value;
+    if (bytes.size() - readAt < sizeof(value))
+    {
+        throw std::runtime_error("Truncated partition message");
+    }
+    std::memcpy(&value, bytes.data() + readAt, sizeof(value));
+    readAt += sizeof(value);
+    return value;
+}
+
+string PartitionMessage::getString()
+{
+    int32_t length = getInt();
+    if (length < 0 || bytes.size() - readAt < static_cast<size_t>(length))
+    {
+        throw std::runtime_error("Truncated partition message");
+    }
+    string text = bytes.substr(readAt, length);
+    readAt += length;
+    return text;
+}
+
+bool PartitionMessage::send(int fd) const
+{
+    // The byte count and the message in one write
+    uint32_t length = static_cast<uint32_t>(bytes.size());
+    string frame(reinterpret_cast<const char *>(&length), sizeof(length));
+    frame += bytes;
+    const char *data = frame.data();
+    size_t left = frame.size();
+    while (left > 0)
+    {
+        ssize_t written = ::send(fd, data, left, MSG_NOSIGNAL);
+        if (written < 0)
+        {
+            if (errno == EINTR)
+                continue;
+            return false;
+        }
+        data += written;
+        left -= written;
+    }
+    return true;
+}
+
+// Exactly length bytes, false if the stream ends first
+static bool readAll(int fd, char *data, size_t length)
+{
+    while (length > 0)
+    {
+        ssize_t got = ::read(fd, data, length);
+        if (got < 0 && errno == EINTR)
+            continue;
+        if (got <= 0)
+            return false;
+        data += got;
+        length -= got;
+    }
+    return true;
+}
+
+bool PartitionMessage::receive(int fd)
+{
+    uint32_t length;
+    if (!readAll(fd, reinterpret_cast<char *>(&length), sizeof(length)))
+        return false;
+    bytes.resize(length);
+    readAt = 0;
+    return readAll(fd, &bytes[0], length);
+}
+
+// Runs the action, replies whether it completed and what it printed
+static void putOutcome(PartitionMessage &reply, WareHouse &wareHouse, BaseAction &action)
+{
+    string printed;
+    output.beginCapture(printed);
+    action.act(wareHouse);
+    output.endCapture();
+    reply.putInt(action.getStatus() == ActionStatus::COMPLETED);
+    reply.putString(printed);
+}
+
+static void putOrders(PartitionMessage &reply, const vector<Order *> &orders)
+{
+    reply.putInt(static_cast<int32_t>(orders.size()));
+    for (const Order *order : orders)
+    {
+        reply.putInt(order->getId());
+        reply.putInt(order->getCustomerId());
+        reply.putInt(static_cast<int32_t>(order->getStatus()));
+    }
+}
+
+// Answers one request from the coordinator, false once the partition should exit
+static bool serveRequest(WareHouse &wareHouse, PartitionMessage &request, PartitionMessage &reply)
+{
+    PartitionRequest kind = static_cast<PartitionRequest>(request.getInt());
+    if (kind == PartitionRequest::STEP)
+    {
+        SimulateStep action(request.getInt());
+        action.act(wareHouse);
+        reply.putInt(1);
+    }
+    else if (kind == PartitionRequest::ORDER)
+    {
+        int orderId = wareHouse.getOrderCounter();
+        AddOrder action(request.getInt());
+        action.act(wareHouse);
+        reply.putInt(wareHouse.getOrderCounter() > orderId ? orderId : -1);
+    }
+    else if (kind == PartitionRequest::CUSTOMER)
+    {
+        string name = request.getString();
+        string type = request.getString();
+        int distance = request.getInt();
+        int maxOrders = request.getInt();
+        AddCustomer action(name, type, distance, maxOrders);
+        putOutcome(reply, wareHouse, action);
+    }
+    else if (kind == PartitionRequest::ORDER_STATUS)
+    {
+        // Every id below the counter is live or archived
+        int orderId = request.getInt();
+        ArchivedOrder archived;
+        if (orderId < 0 || orderId >= wareHouse.getOrderCounter())
+        {
+            reply.putInt(0);
+        }
+        else if (wareHouse.getCompletedOrders().find(orderId, archived))
+        {
+            reply.putInt(1);
+            reply.putInt(static_cast<int32_t>(OrderStatus::COMPLETED));
+            reply.putInt(archived.customerId);
+            reply.putInt(archived.collectorId);
+            reply.putInt(archived.driverId);
+        }
+        else
+        {
+            const Order &order = wareHouse.getOrder(orderId);
+            reply.putInt(1);
+            reply.putInt(static_cast<int32_t>(order.getStatus()));
+            reply.putInt(order.getCustomerId());
+            reply.putInt(order.getCollectorId());
+            reply.putInt(order.getDriverId());
+        }
+    }
+    else if (kind == PartitionRequest::CUSTOMER_STATUS)
+    {
+        int customerId = request.getInt();
+        if (customerId < 0 || customerId >= wareHouse.getCustomerCounter())
+        {
+            reply.putInt(0);
+        }
+        else
+        {
+            const Customer *customer = wareHouse.getCustomers()[customerId]; // Indexed by id
+            reply.putInt(1);
+            reply.putInt(customer->getMaxOrders());
+            reply.putInt(static_cast<int32_t>(customer->getOrdersIds().size()));
+            for (int orderId : customer->getOrdersIds())
+            {
+                reply.putInt(orderId);
+                reply.putInt(static_cast<int32_t>(wareHouse.getOrderStatus(orderId)));
+            }
+        }
+    }
+    else if (kind == PartitionRequest::VOLUNTEER_STATUS)
+    {
+        int volunteerId = request.getInt();
+        const Volunteer *volunteer = nullptr;
+        for (const Volunteer *candidate : wareHouse.getVolunteers())
+        {
+            if (candidate->getId() == volunteerId)
+                volunteer = candidate;
+        }
+        reply.putInt(volunteer != nullptr);
+        if (volunteer != nullptr)
+        {
+            VolunteerRecord record = wareHouse.getVolunteerRecord(volunteer);
+            reply.putInt(record.id);
+            reply.putInt(record.activeOrderId);
+            reply.putInt(record.timeLeft);
+            reply.putInt(record.ordersLeft);
+        }
+    }
+    else if (kind == PartitionRequest::SUMMARY)
+    {
+        const WareHouseSummary &summary = wareHouse.getSummary();
+        for (int value : {wareHouse.getCurrentTick(), summary.pendingOrders, summary.collectingOrders, summary.deliveringOrders,
+                          summary.completedOrders, summary.busyVolunteers, summary.customersAtLimit,
+                          static_cast<int>(wareHouse.getVolunteers().size()), static_cast<int>(wareHouse.getCustomers().size())})
+        {
+            reply.putInt(value);
+        }
+    }
+    else if (kind == PartitionRequest::BACKUP)
+    {
+        BackupWareHouse action;
+        action.act(wareHouse);
+        reply.putInt(1);
+    }
+    else if (kind == PartitionRequest::RESTORE)
+    {
+        RestoreWareHouse action;
+        putOutcome(reply, wareHouse, action);
+    }
+    else if (kind == PartitionRequest::CLOSE)
+    {
+        putOrders(reply, wareHouse.getPendingOrders());
+        putOrders(reply, wareHouse.getInProcessOrders());
+        vector<ArchivedOrder> completed;
+        OrderArchive::Cursor cursor(wareHouse.getCompletedOrders());
+        ArchivedOrder order;
+        while (cursor.next(order))
+        {
+            completed.push_back(order);
+        }
+        reply.putInt(static_cast<int32_t>(completed.size()));
+        for (const ArchivedOrder &archived : completed)
+        {
+            reply.putInt(archived.id);
+            reply.putInt(archived.customerId);
+            reply.putInt(static_cast<int32_t>(OrderStatus::COMPLETED));
+        }
+        Close action;
+        action.act(wareHouse);
+        return false;
+    }
+    else
+    {
+        throw std::runtime_error("Unknown partition request");
+    }
+    return true;
+}
+
+// Body of a partition process: serves the coordinator until CLOSE or until it goes away
+static int servePartition(int fd, const string &configFilePath)
+{
+    // Replies carry everything the coordinator prints
+    output.redirect("/dev/null");
+    PartitionMessage ready;
+    std::unique_ptr<WareHouse> wareHouse;
+    try
+    {
+        wareHouse.reset(new WareHouse(configFilePath));
+        wareHouse->open();
+        ready.putInt(1);
+    }
+    catch (const std::exception &exception)
+    {
+        ready.putInt(0);
+        ready.putString(exception.what());
+    }
+    if (!ready.send(fd) || wareHouse == nullptr)
+        return 1;
+
+    PartitionMessage request;
+    bool serving = true;
+    while (serving && request.receive(fd))
+    {
+        PartitionMessage reply;
+        serving = serveRequest(*wareHouse, request, reply);
+        if (!reply.send(fd))
+            return 1;
+    }
+    delete backup;
+    backup = nullptr;
+    return 0;
+}
+
+PartitionedWareHouse::PartitionedWareHouse(const string &configFilePath, int partitionCount)
+    : partitionCount(partitionCount), pids(), fds(), customerCounter(0), volunteerSlots(), volunteerIds(partitionCount > 0 ? partitionCount : 0),
+      orderSlots(), orderIds(partitionCount > 0 ? partitionCount : 0), actionsLog(), backedUp(false), savedCustomerCounter(0),
+      savedOrderSlots(), savedOrderIds(), savedActionsLog()
+{
+    if (partitionCount <= 0)
+    {
+        throw std::invalid_argument("Partition count must be positive");
+    }
+    std::ifstream inputFile(configFilePath);
+    if (!inputFile.is_open())
+    {
+        throw std::invalid_argument("Could not open configuration file");
+    }
+
+    // Deal the lines out as they are read, the whole file is never held
+    vector<string> configPaths;
+    vector<std::ofstream> configFiles;
+    for (int i = 0; i < partitionCount; i++)
+    {
+        char path[] = PARTITION_CONFIG_TEMPLATE;
+        int fd = mkstemp(path);
+        if (fd < 0)
+        {
+            for (const string &written : configPaths)
+                unlink(written.c_str());
+            throw std::runtime_error("Cannot create a partition configuration file");
+        }
+        close(fd);
+        configPaths.push_back(path);
+        configFiles.emplace_back(path);
+    }
+    int collectors = 0;
+    int drivers = 0;
+    string line;
+    while (std::getline(inputFile, line))
+    {
+        std::istringstream tokens(line);
+        string kind, name, role;
+        tokens >> kind >> name >> role;
+        int partition = -1;
+        if (kind == "customer")
+        {
+            partition = customerCounter++ % partitionCount;
+        }
+        else if (kind == "volunteer")
+        {
+            bool collector = role == "collector" || role == "limited_collector";
+            partition = (collector ? collectors++ : drivers++) % partitionCount;
+            int localId = static_cast<int>(volunteerIds[partition].size());
+            volunteerSlots.push_back(PartitionSlot{partition, localId});
+            volunteerIds[partition].push_back(static_cast<int>(volunteerSlots.size()) - 1);
+        }
+        if (partition >= 0)
+            configFiles[partition] << line << '\n';
+    }
+    configFiles.clear();
+
+    try
+    {
+        spawn(configPaths);
+    }
+    catch (const std::exception &)
+    {
+        for (const string &path : configPaths)
+            unlink(path.c_str());
+        for (int fd : fds)
+            close(fd);
+        for (pid_t pid : pids)
+            waitpid(pid, nullptr, 0);
+        throw;
+    }
+    for (const string &path : configPaths)
+        unlink(path.c_str());
+}
+
+void PartitionedWareHouse::spawn(const vector<string> &configPaths)
+{
+    // Whatever is buffered would be written again by every child
+    output.flush();
+    std::cout.flush();
+    for (int partition = 0; partition < partitionCount; partition++)
+    {
+        int ends[2];
+        if (socketpair(AF_UNIX, SOCK_STREAM, 0, ends) != 0)
+        {
+            throw std::runtime_error(string("socketpair: ") + strerror(errno));
+        }
+        pid_t pid = fork();
+        if (pid < 0)
+        {
+            close(ends[0]);
+            close(ends[1]);
+            throw std::runtime_error(string("fork: ") + strerror(errno));
+        }
+        if (pid == 0)
+        {
+            // The other partitions' sockets stay with the coordinator, so they see it go away
+            for (int fd : fds)
+                close(fd);
+            close(ends[0]);
+            _exit(servePartition(ends[1], configPaths[partition]));
+        }
+        close(ends[1]);
+        pids.push_back(pid);
+        fds.push_back(ends[0]);
+    }
+
+    // Every partition reads its file before any of them is waited for
+    for (int partition = 0; partition < partitionCount; partition++)
+    {
+        PartitionMessage ready;
+        if (!ready.receive(fds[partition]))
+        {
+            throw std::runtime_error("Partition " + std::to_string(partition) + " did not start");
+        }
+        if (ready.getInt() != 1)
+        {
+            throw std::runtime_error("Partition " + std::to_string(partition) + ": " + ready.getString());
+        }
+    }
+}
+
+PartitionedWareHouse::~PartitionedWareHouse()
+{
+    // A partition exits at the end of its stream
+    for (int fd : fds)
+    {
+        close(fd);
+    }
+    for (pid_t pid : pids)
+    {
+        waitpid(pid, nullptr, 0);
+    }
+}
+
+PartitionMessage PartitionedWareHouse::call(int partition, const PartitionMessage &request)
+{
+    PartitionMessage reply;
+    if (!request.send(fds[partition]) || !reply.receive(fds[partition]))
+    {
+        throw std::runtime_error("Partition " + std::to_string(partition) + " is gone");
+    }
+    return reply;
+}
+
+vector<PartitionMessage> PartitionedWareHouse::gather(const PartitionMessage &request)
+{
+    // All partitions work on it at once, the replies are the barrier
+    for (int partition = 0; partition < partitionCount; partition++)
+    {
+        if (!request.send(fds[partition]))
+            throw std::runtime_error("Partition " + std::to_string(partition) + " is gone");
+    }
+    vector<PartitionMessage> replies(partitionCount);
+    for (int partition = 0; partition < partitionCount; partition++)
+    {
+        if (!replies[partition].receive(fds[partition]))
+            throw std::runtime_error("Partition " + std::to_string(partition) + " is gone");
+    }
+    return replies;
+}
+
+int PartitionedWareHouse::globalCustomer(int partition, int localId) const
+{
+    return localId * partitionCount + partition;
+}
+
+int PartitionedWareHouse::globalVolunteer(int partition, int localId) const
+{
+    return localId == NO_VOLUNTEER ? NO_VOLUNTEER : volunteerIds[partition][localId];
+}
+
+int PartitionedWareHouse::globalOrder(int partition, int localId) const
+{
+    return localId == NO_ORDER ? NO_ORDER : orderIds[partition][localId];
+}
+
+void PartitionedWareHouse::appendOrders(string &buffer, int partition, PartitionMessage &reply) const
+{
+    // As Close prints them
+    for (int count = reply.getInt(); count > 0; count--)
+    {
+        int orderId = reply.getInt();
+        int customerId = reply.getInt();
+        OrderStatus status = static_cast<OrderStatus>(reply.getInt());
+        appendText(buffer, "OrderID: ");
+        appendInt(buffer, globalOrder(partition, orderId));
+        appendText(buffer, " , CustomerID: ");
+        appendInt(buffer, globalCustomer(partition, customerId));
+        appendText(buffer, " , Status: ");
+        appendText(buffer, Order::getStatusString(status));
+        buffer += '\n';
+    }
+}
+
+void PartitionedWareHouse::logAction(const BaseAction &action, ActionError error)
+{
+    // The action only describes the command, the partitions ran it
+    ActionRecord record = action.toRecord();
+    record.status = error == ActionError::NONE ? ActionStatus::COMPLETED : ActionStatus::ERROR;
+    record.error = error;
+    actionsLog.append(record, action.getRecordText());
+}
+
+// The error of an action's "Error: <message>" line, NONE if it printed none
+static ActionError errorMessage(const string &printed)
+{
+    if (printed.compare(0, 7, "Error: ") != 0)
+        return ActionError::NONE;
+    return findActionError(std::string_view(printed).substr(7, printed.find('\n') - 7));
+}
+
+bool PartitionedWareHouse::execute(const string &userInput)
+{
+    std::istringstream arguments(userInput);
+    string command;
+    arguments >> command;
+    int id = -1;
+    string report;
+    if (command == "step")
+    {
+        int numberOfSteps = -1;
+        if (!(arguments >> numberOfSteps) || numberOfSteps < 0)
+        {
+            report = "Invalid step: " + userInput + "\n";
+        }
+        else
+        {
+            PartitionMessage request(PartitionRequest::STEP);
+            request.putInt(numberOfSteps);
+            gather(request);
+            logAction(SimulateStep(numberOfSteps), ActionError::NONE);
+        }
+    }
+    else if (command == "order")
+    {
+        bool placed = false;
+        if (arguments >> id && id >= 0 && id < customerCounter)
+        {
+            int partition = id % partitionCount;
+            PartitionMessage request(PartitionRequest::ORDER);
+            request.putInt(id / partitionCount);
+            PartitionMessage reply = call(partition, request);
+            int localId = reply.getInt();
+            if (localId >= 0)
+            {
+                orderIds[partition].push_back(static_cast<int>(orderSlots.size()));
+                orderSlots.push_back(PartitionSlot{partition, localId});
+                placed = true;
+            }
+        }
+        if (!placed)
+            report = "Error: Cannot place this order\n";
+        logAction(AddOrder(id), errorMessage(report));
+    }
+    else if (command == "customer")
+    {
+        string name, type;
+        int distance = -1, maxOrders = 0;
+        arguments >> name >> type >> distance >> maxOrders;
+        PartitionMessage request(PartitionRequest::CUSTOMER);
+        request.putString(name);
+        request.putString(type);
+        request.putInt(distance);
+        request.putInt(maxOrders);
+        PartitionMessage reply = call(customerCounter % partitionCount, request);
+        if (reply.getInt() == 1)
+            customerCounter++;
+        report = reply.getString();
+        logAction(AddCustomer(name, type, distance, maxOrders), errorMessage(report));
+    }
+    else if (command == "orderStatus")
+    {
+        bool found = false;
+        if (arguments >> id && id >= 0 && id < static_cast<int>(orderSlots.size()))
+        {
+            const PartitionSlot &slot = orderSlots[id];
+            PartitionMessage request(PartitionRequest::ORDER_STATUS);
+            request.putInt(slot.localId);
+            PartitionMessage reply = call(slot.partition, request);
+            found = reply.getInt() == 1;
+            if (found)
+            {
+                OrderStatus status = static_cast<OrderStatus>(reply.getInt());
+                int customerId = globalCustomer(slot.partition, reply.getInt());
+                int collectorId = globalVolunteer(slot.partition, reply.getInt());
+                int driverId = globalVolunteer(slot.partition, reply.getInt());
+                Snapshot::appendOrderStatus(report, id, status, customerId, collectorId, driverId);
+            }
+        }
+        if (!found)
+            report = "Error: Order doesnt exist\n";
+        logAction(PrintOrderStatus(id), errorMessage(report));
+    }
+    else if (command == "customerStatus")
+    {
+        bool found = false;
+        if (arguments >> id && id >= 0 && id < customerCounter)
+        {
+            int partition = id % partitionCount;
+            PartitionMessage request(PartitionRequest::CUSTOMER_STATUS);
+            request.putInt(id / partitionCount);
+            PartitionMessage reply = call(partition, request);
+            found = reply.getInt() == 1;
+            if (found)
+            {
+                int maxOrders = reply.getInt();
+                int orders = reply.getInt();
+                appendText(report, "CustomerID: ");
+                appendInt(report, id);
+                report += '\n';
+                for (int i = 0; i < orders; i++)
+                {
+                    int orderId = globalOrder(partition, reply.getInt());
+                    Snapshot::appendOrderLine(report, orderId, static_cast<OrderStatus>(reply.getInt()));
+                }
+                appendText(report, "numOrdersLeft: ");
+                appendInt(report, maxOrders - orders);
+                report += '\n';
+            }
+        }
+        if (!found)
+            report = "Error: Customer doesnt exist\n";
+        logAction(PrintCustomerStatus(id), errorMessage(report));
+    }
+    else if (command == "volunteerStatus")
+    {
+        bool found = false;
+        if (arguments >> id && id >= 0 && id < static_cast<int>(volunteerSlots.size()))
+        {
+            const PartitionSlot &slot = volunteerSlots[id];
+            PartitionMessage request(PartitionRequest::VOLUNTEER_STATUS);
+            request.putInt(slot.localId);
+            PartitionMessage reply = call(slot.partition, request);
+            found = reply.getInt() == 1;
+            if (found)
+            {
+                VolunteerRecord record;
+                record.id = globalVolunteer(slot.partition, reply.getInt());
+                record.activeOrderId = globalOrder(slot.partition, reply.getInt());
+                record.timeLeft = reply.getInt();
+                record.ordersLeft = reply.getInt();
+                Snapshot::appendVolunteerStatus(report, record);
+            }
+        }
+        if (!found)
+            report = "Error: Volunteer doesnt exist\n";
+        logAction(PrintVolunteerStatus(id), errorMessage(report));
+    }
+    else if (command == "summary")
+    {
+        // Summed as WareHouse::appendSummary prints one warehouse
+        long long totals[9] = {0};
+        for (PartitionMessage &reply : gather(PartitionMessage(PartitionRequest::SUMMARY)))
+        {
+            for (long long &total : totals)
+                total += reply.getInt();
+        }
+        long long tick = totals[0] / partitionCount; // The partitions step together
+        appendText(report, "Partitions: ");
+        appendInt(report, partitionCount);
+        appendText(report, "\nTick: ");
+        appendInt(report, tick);
+        appendText(report, "\nOrders: pending ");
+        appendInt(report, totals[1]);
+        appendText(report, ", collecting ");
+        appendInt(report, totals[2]);
+        appendText(report, ", delivering ");
+        appendInt(report, totals[3]);
+        appendText(report, ", completed ");
+        appendInt(report, totals[4]);
+        appendText(report, "\nVolunteers: ");
+        appendInt(report, totals[7]);
+        appendText(report, ", busy ");
+        appendInt(report, totals[5]);
+        appendText(report, ", idle ");
+        appendInt(report, totals[7] - totals[5]);
+        appendText(report, "\nCustomers: ");
+        appendInt(report, totals[8]);
+        appendText(report, ", at order limit ");
+        appendInt(report, totals[6]);
+        report += '\n';
+    }
+    else if (userInput == "backup")
+    {
+        gather(PartitionMessage(PartitionRequest::BACKUP));
+        logAction(BackupWareHouse(), ActionError::NONE); // Before the copy, as the action logs itself
+        backedUp = true;
+        savedCustomerCounter = customerCounter;
+        savedOrderSlots = orderSlots;
+        savedOrderIds = orderIds;
+        savedActionsLog = actionsLog;
+    }
+    else if (userInput == "restore")
+    {
+        // The partitions back up together, so they all have a backup or none does
+        vector<PartitionMessage> replies = gather(PartitionMessage(PartitionRequest::RESTORE));
+        bool restored = replies[0].getInt() == 1;
+        report = replies[0].getString();
+        if (restored && backedUp)
+        {
+            customerCounter = savedCustomerCounter;
+            orderSlots = savedOrderSlots;
+            orderIds = savedOrderIds;
+            actionsLog = savedActionsLog;
+        }
+        logAction(RestoreWareHouse(), errorMessage(report));
+    }
+    else if (userInput == "log")
+    {
+        for (size_t i = 0; i < actionsLog.size(); i++)
+        {
+            actionsLog.appendLine(i, report);
+        }
+        logAction(PrintActionsLog(), ActionError::NONE);
+    }
+    else if (userInput == "close")
+    {
+        // Pending, in-process and completed orders of every partition, section by section
+        vector<PartitionMessage> replies = gather(PartitionMessage(PartitionRequest::CLOSE));
+        for (int section = 0; section < 3; section++)
+        {
+            for (int partition = 0; partition < partitionCount; partition++)
+            {
+                appendOrders(report, partition, replies[partition]);
+            }
+        }
+        output << report;
+        return false;
+    }
+    else
+    {
+        report = "Invalid action!\n";
+    }
+    output << report;
+    return true;
+}
+
+void PartitionedWareHouse::start()
+{
+    std::cout << "Warehouse is open on " << partitionCount << " partitions!" << std::endl;
+    string userInput;
+    try
+    {
+        while (true)
+        {
+            output.flush();
+            std::cout << "Enter an action: " << std::flush;
+            if (!std::getline(std::cin, userInput) || !execute(userInput))
+                break;
+        }
+    }
+    catch (const std::runtime_error &exception)
+    {
+        output << exception.what() << '\n';
+    }
+    output.flush();
+}
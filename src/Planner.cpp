@@ -0,0 +1,312 @@
+#include "../include/Planner.h"
+#include "../include/WareHouse.h"
+#include "../include/Volunteer.h"
+#include "../include/Format.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+
+CapacityPlanner::CapacityPlanner(const WareHouse &wareHouse, int horizon)
+    : wareHouse(wareHouse), horizon(horizon), collector(), driver(),
+      openOrders(static_cast<int>(wareHouse.getPendingOrders().size() + wareHouse.getInProcessOrders().size())),
+      unreachable(0), found(false), best{0, 0, false, horizon}, probesRun(0), elapsedMs(0)
+{
+    if (horizon <= 0)
+    {
+        throw std::invalid_argument("Horizon must be positive");
+    }
+}
+
+static int parseCount(const string &token)
+{
+    size_t used = 0;
+    int count = -1;
+    try
+    {
+        count = std::stoi(token, &used);
+    }
+    catch (const std::exception &)
+    {
+        used = 0;
+    }
+    if (used != token.size() || count < 0)
+    {
+        throw std::invalid_argument("Not a count: " + token);
+    }
+    return count;
+}
+
+void CapacityPlanner::setVolunteers(const string &text)
+{
+    std::istringstream stream(text);
+    vector<string> tokens;
+    string token;
+    while (stream >> token)
+    {
+        tokens.push_back(token);
+    }
+    for (size_t i = 0; i < tokens.size();)
+    {
+        if (tokens[i] == "collector" && i + 1 < tokens.size())
+        {
+            parseCount(tokens[i + 1]);
+            collector = {"volunteer", "plan", "collector", tokens[i + 1]};
+            i += 2;
+            if (i + 1 < tokens.size() && tokens[i] == "wave")
+            {
+                parseCount(tokens[i + 1]);
+                collector.insert(collector.end(), {"wave", tokens[i + 1]});
+                i += 2;
+            }
+        }
+        else if (tokens[i] == "driver" && i + 2 < tokens.size())
+        {
+            parseCount(tokens[i + 1]);
+            parseCount(tokens[i + 2]);
+            driver = {"volunteer", "plan", "driver", tokens[i + 1], tokens[i + 2]};
+            i += 3;
+        }
+        else
+        {
+            throw std::invalid_argument("Unknown volunteer: " + tokens[i]);
+        }
+    }
+
+    // Model the roles left out on the first volunteers of the warehouse, limited or not
+    for (const Volunteer *volunteer : wareHouse.getVolunteers())
+    {
+        const CollectorVolunteer *collectorVolunteer = dynamic_cast<const CollectorVolunteer *>(volunteer);
+        const DriverVolunteer *driverVolunteer = dynamic_cast<const DriverVolunteer *>(volunteer);
+        if (collector.empty() && collectorVolunteer != nullptr)
+        {
+            collector = {"volunteer", "plan", "collector", std::to_string(collectorVolunteer->getCoolDown())};
+            if (collectorVolunteer->getWaveSize() > 1)
+                collector.insert(collector.end(), {"wave", std::to_string(collectorVolunteer->getWaveSize())});
+        }
+        if (driver.empty() && driverVolunteer != nullptr)
+        {
+            driver = {"volunteer", "plan", "driver", std::to_string(driverVolunteer->getMaxDistance()),
+                      std::to_string(driverVolunteer->getDistancePerStep())};
+        }
+    }
+    if (collector.empty() || driver.empty())
+    {
+        throw std::invalid_argument(string("No ") + (collector.empty() ? "collector" : "driver") + " to model on");
+    }
+}
+
+void CapacityPlanner::runProbes(vector<PlanProbe> &probes)
+{
+    // Copy and add the volunteers here: adding volunteers interns their names
+    vector<std::unique_ptr<WareHouse>> copies;
+    for (const PlanProbe &probe : probes)
+    {
+        copies.emplace_back(new WareHouse(wareHouse));
+        WareHouse &copy = *copies.back();
+        for (int i = 0; i < probe.collectors; i++)
+            copy.addVolunteer(collector);
+        for (int i = 0; i < probe.drivers; i++)
+            copy.addVolunteer(driver);
+    }
+
+    std::atomic<size_t> next(0);
+    auto worker = [&]()
+    {
+        for (size_t i = next++; i < probes.size(); i = next++)
+        {
+            WareHouse &copy = *copies[i];
+            PlanProbe &probe = probes[i];
+            for (probe.ticks = 0; probe.ticks < horizon; probe.ticks++)
+            {
+                if (copy.getPendingOrders().empty() && copy.getInProcessOrders().empty())
+                    break;
+                copy.simulateStep(1);
+            }
+            probe.met = copy.getPendingOrders().empty() && copy.getInProcessOrders().empty();
+            copies[i].reset(); // Free the copy before the next one is simulated
+        }
+    };
+    size_t threadCount = std::min<size_t>(probes.size(), std::max(1u, std::thread::hardware_concurrency()));
+    vector<std::thread> threads;
+    for (size_t i = 1; i < threadCount; i++)
+    {
+        threads.emplace_back(worker);
+    }
+    worker();
+    for (std::thread &thread : threads)
+    {
+        thread.join();
+    }
+    probesRun += static_cast<int>(probes.size());
+}
+
+PlanProbe CapacityPlanner::searchMinimum(const PlanProbe &met, bool collectors)
+{
+    // The count searched is in (low, high], high meets the target
+    const int probesPerRound = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+    PlanProbe result = met;
+    int low = -1;
+    int high = collectors ? met.collectors : met.drivers;
+    while (high - low > 1)
+    {
+        // Evenly spaced counts strictly between low and high
+        int count = std::min(probesPerRound, high - low - 1);
+        vector<PlanProbe> probes;
+        for (int i = 1; i <= count; i++)
+        {
+            PlanProbe probe = result;
+            (collectors ? probe.collectors : probe.drivers) = low + (high - low) * i / (count + 1);
+            probes.push_back(probe);
+        }
+        runProbes(probes);
+
+        auto first = std::find_if(probes.begin(), probes.end(), [](const PlanProbe &probe)
+                                  { return probe.met; });
+        if (first != probes.begin())
+        {
+            const PlanProbe &missed = *(first - 1);
+            low = collectors ? missed.collectors : missed.drivers;
+        }
+        if (first != probes.end())
+        {
+            result = *first;
+            high = collectors ? result.collectors : result.drivers;
+        }
+    }
+    return result;
+}
+
+bool CapacityPlanner::plan()
+{
+    auto started = std::chrono::steady_clock::now();
+    found = false;
+    probesRun = 0;
+
+    // An order beyond the reach of every driver, added or not, is never delivered
+    int reach = std::stoi(driver[3]);
+    for (const Volunteer *volunteer : wareHouse.getVolunteers())
+    {
+        const DriverVolunteer *driverVolunteer = dynamic_cast<const DriverVolunteer *>(volunteer);
+        if (driverVolunteer != nullptr)
+            reach = std::max(reach, driverVolunteer->getMaxDistance());
+    }
+    unreachable = 0;
+    for (const vector<Order *> *queue : {&wareHouse.getPendingOrders(), &wareHouse.getInProcessOrders()})
+    {
+        for (const Order *order : *queue)
+        {
+            if (order->getDriverId() == NO_VOLUNTEER && order->getDistance() > reach)
+                unreachable++;
+        }
+    }
+    if (unreachable > 0)
+    {
+        elapsedMs = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - started).count();
+        return false;
+    }
+
+    // Double both counts until the target is met, up to one of each per open order
+    const int probesPerRound = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+    vector<int> counts = {0};
+    for (int count = 1; counts.back() < openOrders; count *= 2)
+    {
+        counts.push_back(std::min(count, openOrders));
+    }
+    for (size_t first = 0; first < counts.size() && !found; first += probesPerRound)
+    {
+        vector<PlanProbe> probes;
+        for (size_t i = first; i < counts.size() && i < first + probesPerRound; i++)
+        {
+            probes.push_back(PlanProbe{counts[i], counts[i], false, horizon});
+        }
+        runProbes(probes);
+        for (const PlanProbe &probe : probes)
+        {
+            if (probe.met)
+            {
+                best = probe;
+                found = true;
+                break;
+            }
+        }
+    }
+
+    if (found)
+    {
+        best = searchMinimum(best, true);
+        best = searchMinimum(best, false);
+    }
+    elapsedMs = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - started).count();
+    return found;
+}
+
+// "<count> <role>s (<arguments>)"
+static void appendVolunteers(string &buffer, int count, const vector<string> &line)
+{
+    appendInt(buffer, count);
+    buffer += ' ';
+    appendText(buffer, line[2]);
+    appendText(buffer, count == 1 ? " (" : "s (");
+    appendText(buffer, line[2] == "collector" ? "cooldown " : "max distance ");
+    appendText(buffer, line[3]);
+    if (line.size() > 4)
+    {
+        appendText(buffer, line[2] == "collector" ? ", wave " : ", distance per step ");
+        appendText(buffer, line.back());
+    }
+    buffer += ')';
+}
+
+void CapacityPlanner::appendReport(string &buffer) const
+{
+    int collectors = 0;
+    int drivers = 0;
+    for (const Volunteer *volunteer : wareHouse.getVolunteers())
+    {
+        (dynamic_cast<const CollectorVolunteer *>(volunteer) != nullptr ? collectors : drivers)++;
+    }
+
+    appendText(buffer, "Target: ");
+    appendInt(buffer, openOrders);
+    appendText(buffer, " open orders delivered within ");
+    appendInt(buffer, horizon);
+    appendText(buffer, " ticks from tick ");
+    appendInt(buffer, wareHouse.getCurrentTick());
+    buffer += '\n';
+    if (found)
+    {
+        appendText(buffer, "Add ");
+        appendVolunteers(buffer, best.collectors, collector);
+        appendText(buffer, " and ");
+        appendVolunteers(buffer, best.drivers, driver);
+        appendText(buffer, ": delivered in ");
+        appendInt(buffer, best.ticks);
+        appendText(buffer, " ticks\nCollectors: ");
+        appendInt(buffer, collectors + best.collectors);
+        appendText(buffer, ", Drivers: ");
+        appendInt(buffer, drivers + best.drivers);
+        buffer += '\n';
+    }
+    else if (unreachable > 0)
+    {
+        appendText(buffer, "Not met: ");
+        appendInt(buffer, unreachable);
+        appendText(buffer, " open orders are beyond every driver's reach\n");
+    }
+    else
+    {
+        appendText(buffer, "Not met with ");
+        appendInt(buffer, openOrders);
+        appendText(buffer, " more of each role\n");
+    }
+    appendText(buffer, "Probes: ");
+    appendInt(buffer, probesRun);
+    appendText(buffer, " in ");
+    appendInt(buffer, elapsedMs);
+    appendText(buffer, " ms\n");
+}
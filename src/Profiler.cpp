@@ -0,0 +1,345 @@
+#include "../include/Profiler.h"
+#include "../include/Format.h"
+#include "../include/Tracer.h"
+
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <fcntl.h>
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+namespace
+{
+    // The perf events of one thread, read together as a group
+    class CounterGroup
+    {
+    public:
+        CounterGroup() : fds(), positions(), members(0)
+        {
+            for (int i = 0; i < PROFILE_COUNTERS; i++)
+            {
+                fds[i] = -1;
+                positions[i] = -1;
+            }
+            // Cycles lead the group; without them nothing else is opened
+            for (int i = 0; i < PROFILE_COUNTERS; i++)
+            {
+                fds[i] = open(static_cast<ProfileCounter>(i), i == 0 ? -1 : fds[0]);
+                if (fds[i] >= 0)
+                {
+                    positions[i] = members++;
+                }
+                else if (i == 0)
+                {
+                    return;
+                }
+            }
+        }
+
+        ~CounterGroup()
+        {
+            for (int fd : fds)
+            {
+                if (fd >= 0)
+                    close(fd);
+            }
+        }
+
+        CounterGroup(const CounterGroup &other) = delete;
+        CounterGroup &operator=(const CounterGroup &other) = delete;
+
+        void read(ProfileSample &sample) const
+        {
+            // PERF_FORMAT_GROUP layout: count, time enabled, time running, one value per member
+            uint64_t values[3 + PROFILE_COUNTERS];
+            if (members == 0 || ::read(fds[0], values, sizeof(values)) <= 0)
+            {
+                return;
+            }
+            sample.enabled = values[1];
+            sample.running = values[2];
+            for (int i = 0; i < PROFILE_COUNTERS; i++)
+            {
+                if (positions[i] >= 0)
+                    sample.counters[i] = values[3 + positions[i]];
+            }
+        }
+
+    private:
+        static int open(ProfileCounter counter, int groupFd)
+        {
+            perf_event_attr attr;
+            memset(&attr, 0, sizeof(attr));
+            attr.size = sizeof(attr);
+            attr.type = PERF_TYPE_HARDWARE;
+            switch (counter)
+            {
+            case ProfileCounter::CYCLES:
+                attr.config = PERF_COUNT_HW_CPU_CYCLES;
+                break;
+            case ProfileCounter::INSTRUCTIONS:
+                attr.config = PERF_COUNT_HW_INSTRUCTIONS;
+                break;
+            case ProfileCounter::L1D_MISSES:
+                attr.type = PERF_TYPE_HW_CACHE;
+                attr.config = PERF_COUNT_HW_CACHE_L1D | (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                              (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+                break;
+            case ProfileCounter::LLC_MISSES:
+                attr.config = PERF_COUNT_HW_CACHE_MISSES;
+                break;
+            case ProfileCounter::BRANCH_MISSES:
+                attr.config = PERF_COUNT_HW_BRANCH_MISSES;
+                break;
+            }
+            attr.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+            attr.exclude_kernel = 1; // Allowed at perf_event_paranoid 2
+            attr.exclude_hv = 1;
+            // This thread only, on whatever CPU it runs
+            return static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, groupFd, PERF_FLAG_FD_CLOEXEC));
+        }
+
+        int fds[PROFILE_COUNTERS];
+        int positions[PROFILE_COUNTERS]; // Index in the group read, -1 if not counted
+        int members;
+    };
+}
+
+Profiler::Profiler() : mutex(), phases(), commands() {}
+
+ProfileSample Profiler::sample() const
+{
+    thread_local CounterGroup group;
+    ProfileSample sample;
+    sample.nanos = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                       std::chrono::steady_clock::now().time_since_epoch())
+                       .count();
+    for (long long &counter : sample.counters)
+    {
+        counter = PROFILE_UNAVAILABLE;
+    }
+    sample.enabled = 0;
+    sample.running = 0;
+    group.read(sample);
+    return sample;
+}
+
+void Profiler::add(ProfileTotals &totals, const ProfileSample &begin, const ProfileSample &end)
+{
+    totals.calls++;
+    totals.nanos += end.nanos - begin.nanos;
+
+    // The group counted only part of the time it was enabled: extrapolate
+    long long running = end.running - begin.running;
+    long long enabled = end.enabled - begin.enabled;
+    for (int i = 0; i < PROFILE_COUNTERS; i++)
+    {
+        if (begin.counters[i] == PROFILE_UNAVAILABLE || totals.counters[i] == PROFILE_UNAVAILABLE)
+        {
+            totals.counters[i] = PROFILE_UNAVAILABLE;
+            continue;
+        }
+        long long delta = end.counters[i] - begin.counters[i];
+        if (running > 0 && running < enabled)
+        {
+            delta = static_cast<long long>(static_cast<double>(delta) * enabled / running);
+        }
+        totals.counters[i] += delta;
+    }
+}
+
+void Profiler::addPhase(ProfilePhase phase, const ProfileSample &begin, const ProfileSample &end)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    add(phases[static_cast<int>(phase)], begin, end);
+}
+
+void Profiler::addCommand(const string &command, const ProfileSample &begin)
+{
+    ProfileSample end = sample();
+    std::lock_guard<std::mutex> lock(mutex);
+    add(commands[command], begin, end);
+}
+
+void Profiler::reset()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    for (ProfileTotals &totals : phases)
+    {
+        totals = ProfileTotals();
+    }
+    commands.clear();
+}
+
+const char *Profiler::getPhaseString(ProfilePhase phase)
+{
+    switch (phase)
+    {
+    case ProfilePhase::DRAIN:
+        return "drain";
+    case ProfilePhase::ASSIGN:
+        return "assign";
+    case ProfilePhase::STEP:
+        return "step";
+    case ProfilePhase::FINISH:
+        return "finish";
+    case ProfilePhase::DELETE:
+        return "delete";
+    case ProfilePhase::PUBLISH:
+        return "publish";
+    }
+    return "";
+}
+
+const char *Profiler::getCounterString(ProfileCounter counter)
+{
+    switch (counter)
+    {
+    case ProfileCounter::CYCLES:
+        return "Cycles";
+    case ProfileCounter::INSTRUCTIONS:
+        return "Instructions";
+    case ProfileCounter::L1D_MISSES:
+        return "L1D misses";
+    case ProfileCounter::LLC_MISSES:
+        return "LLC misses";
+    case ProfileCounter::BRANCH_MISSES:
+        return "Branch misses";
+    }
+    return "";
+}
+
+void Profiler::appendTotals(string &buffer, const ProfileTotals &totals)
+{
+    appendText(buffer, ", Calls: ");
+    appendInt(buffer, totals.calls);
+    appendText(buffer, ", Time: ");
+    appendInt(buffer, totals.nanos / 1000);
+    appendText(buffer, " us");
+    for (int i = 0; i < PROFILE_COUNTERS; i++)
+    {
+        appendText(buffer, ", ");
+        appendText(buffer, getCounterString(static_cast<ProfileCounter>(i)));
+        appendText(buffer, ": ");
+        if (totals.counters[i] == PROFILE_UNAVAILABLE)
+            appendText(buffer, "n/a");
+        else
+            appendInt(buffer, totals.counters[i]);
+    }
+    buffer += '\n';
+}
+
+void Profiler::appendReport(string &buffer) const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    for (int i = 0; i < PROFILE_PHASES; i++)
+    {
+        appendText(buffer, "Phase: ");
+        appendText(buffer, getPhaseString(static_cast<ProfilePhase>(i)));
+        appendTotals(buffer, phases[i]);
+    }
+    for (const auto &command : commands)
+    {
+        appendText(buffer, "Command: ");
+        appendText(buffer, command.first);
+        appendTotals(buffer, command.second);
+    }
+}
+
+void Profiler::appendCsv(string &buffer, const char *kind, const string &name, const ProfileTotals &totals)
+{
+    appendText(buffer, kind);
+    buffer += ',';
+    appendText(buffer, name);
+    buffer += ',';
+    appendInt(buffer, totals.calls);
+    buffer += ',';
+    appendInt(buffer, totals.nanos);
+    for (long long counter : totals.counters)
+    {
+        // Left empty when not counted
+        buffer += ',';
+        if (counter != PROFILE_UNAVAILABLE)
+            appendInt(buffer, counter);
+    }
+    buffer += '\n';
+}
+
+bool Profiler::dump(const string &path) const
+{
+    string buffer = "kind,name,calls,nanoseconds,cycles,instructions,l1d_misses,llc_misses,branch_misses\n";
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        for (int i = 0; i < PROFILE_PHASES; i++)
+        {
+            appendCsv(buffer, "phase", getPhaseString(static_cast<ProfilePhase>(i)), phases[i]);
+        }
+        for (const auto &command : commands)
+        {
+            appendCsv(buffer, "command", command.first, command.second);
+        }
+    }
+
+    int fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (fd < 0)
+    {
+        return false;
+    }
+    size_t written = 0;
+    while (written < buffer.size())
+    {
+        ssize_t result = ::write(fd, buffer.data() + written, buffer.size() - written);
+        if (result <= 0)
+        {
+            break;
+        }
+        written += result;
+    }
+    return ::close(fd) == 0 && written == buffer.size();
+}
+
+ProfileScope::ProfileScope(Profiler *profiler, Tracer *tracer, int tick, ProfilePhase phase)
+    : profiler(profiler), tracer(tracer), tick(tick), phase(phase), begin(), tickBegin(0), phaseBegin(0)
+{
+    if (profiler != nullptr)
+    {
+        begin = profiler->sample();
+    }
+    if (tracer != nullptr)
+    {
+        tickBegin = phaseBegin = tracer->now();
+    }
+}
+
+ProfileScope::~ProfileScope()
+{
+    endPhase();
+    if (tracer != nullptr)
+    {
+        tracer->tick(tick, tickBegin, phaseBegin);
+    }
+}
+
+void ProfileScope::next(ProfilePhase nextPhase)
+{
+    endPhase();
+    phase = nextPhase;
+}
+
+void ProfileScope::endPhase()
+{
+    if (profiler != nullptr)
+    {
+        ProfileSample end = profiler->sample();
+        profiler->addPhase(phase, begin, end);
+        begin = end;
+    }
+    if (tracer != nullptr)
+    {
+        long long end = tracer->now();
+        tracer->phase(phase, tick, phaseBegin, end);
+        phaseBegin = end;
+    }
+}
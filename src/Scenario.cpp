@@ -0,0 +1,331 @@
+#include "../include/Scenario.h"
+#include "../include/WareHouse.h"
+#include "../include/Customer.h"
+#include "../include/Format.h"
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+
+#define SCENARIO_NAME_WIDTH 32
+
+ScenarioRunner::ScenarioRunner(const WareHouse &wareHouse, int horizon) : wareHouse(wareHouse), horizon(horizon), runs()
+{
+    if (horizon <= 0)
+    {
+        throw std::invalid_argument("Horizon must be positive");
+    }
+}
+
+static int parseCount(const string &token)
+{
+    size_t used = 0;
+    int count = -1;
+    try
+    {
+        count = std::stoi(token, &used);
+    }
+    catch (const std::exception &)
+    {
+        used = 0;
+    }
+    if (used != token.size() || count < 0)
+    {
+        throw std::invalid_argument("Not a count: " + token);
+    }
+    return count;
+}
+
+Mutation ScenarioRunner::parseMutation(const string &text)
+{
+    std::istringstream stream(text);
+    vector<string> tokens;
+    string token;
+    while (stream >> token)
+    {
+        tokens.push_back(token);
+    }
+    if (tokens.empty())
+    {
+        throw std::invalid_argument("Empty mutation");
+    }
+    string words = tokens[0];
+    for (size_t i = 1; i < tokens.size(); i++)
+    {
+        words += " " + tokens[i];
+    }
+
+    Mutation mutation = {MutationKind::VOLUNTEERS, 0, -1, "", {}};
+    if (tokens[0] == "add" && tokens.size() >= 4)
+    {
+        // The arguments are checked the way the configuration file is: not at all, beyond their number
+        static const std::pair<const char *, size_t> roles[] = {
+            {"collector", 4}, {"limited_collector", 5}, {"driver", 5}, {"limited_driver", 6}};
+        auto role = std::find_if(std::begin(roles), std::end(roles), [&](const std::pair<const char *, size_t> &known)
+                                 { return tokens[2] == known.first; });
+        // Collectors may end in "wave <size>"
+        bool wave = role != std::end(roles) && tokens[2].find("collector") != string::npos &&
+                    tokens.size() == role->second + 2 && tokens[role->second] == "wave";
+        if (role == std::end(roles) || (tokens.size() != role->second && !wave))
+        {
+            throw std::invalid_argument("Unknown volunteer: " + words);
+        }
+        for (size_t i = 3; i < tokens.size(); i++)
+        {
+            if (!wave || i != role->second)
+                parseCount(tokens[i]);
+        }
+        mutation.count = parseCount(tokens[1]);
+        mutation.volunteer = {"volunteer", "scenario"};
+        mutation.volunteer.insert(mutation.volunteer.end(), tokens.begin() + 2, tokens.end());
+    }
+    else if (tokens[0] == "orders" && tokens.size() == 3)
+    {
+        mutation.kind = MutationKind::ORDERS;
+        mutation.count = parseCount(tokens[1]);
+        mutation.customerId = parseCount(tokens[2]);
+    }
+    else if (tokens[0] == "demand" && tokens.size() == 3 &&
+             (tokens[2] == "soldier" || tokens[2] == "civilian" || tokens[2] == "all"))
+    {
+        mutation.kind = MutationKind::DEMAND;
+        mutation.count = parseCount(tokens[1]);
+        mutation.customerType = tokens[2];
+    }
+    else
+    {
+        throw std::invalid_argument("Unknown mutation: " + words);
+    }
+    return mutation;
+}
+
+vector<Scenario> ScenarioRunner::parse(const string &text)
+{
+    vector<Scenario> scenarios;
+    std::istringstream stream(text);
+    string scenarioText;
+    while (std::getline(stream, scenarioText, ';'))
+    {
+        Scenario scenario = {"", {}};
+        std::istringstream mutations(scenarioText);
+        string mutationText;
+        while (std::getline(mutations, mutationText, ','))
+        {
+            scenario.mutations.push_back(parseMutation(mutationText));
+        }
+        std::istringstream words(scenarioText);
+        string word;
+        while (words >> word)
+        {
+            scenario.name += scenario.name.empty() ? word : " " + word;
+        }
+        scenarios.push_back(scenario);
+    }
+    return scenarios;
+}
+
+static bool matchesType(const Customer *customer, const string &customerType)
+{
+    if (customerType == "soldier")
+        return dynamic_cast<const SoldierCustomer *>(customer) != nullptr;
+    if (customerType == "civilian")
+        return dynamic_cast<const CivilianCustomer *>(customer) != nullptr;
+    return true;
+}
+
+void ScenarioRunner::run(const vector<Scenario> &scenarios)
+{
+    runs.clear();
+    runs.push_back(Run{Scenario{"baseline", {}}, ScenarioResult()});
+    for (const Scenario &scenario : scenarios)
+    {
+        runs.push_back(Run{scenario, ScenarioResult()});
+    }
+
+    // Copy and apply the one-off mutations here: adding volunteers interns their names
+    vector<std::unique_ptr<WareHouse>> copies;
+    for (const Run &run : runs)
+    {
+        copies.emplace_back(new WareHouse(wareHouse));
+        WareHouse &copy = *copies.back();
+        for (const Mutation &mutation : run.scenario.mutations)
+        {
+            if (mutation.kind == MutationKind::VOLUNTEERS)
+            {
+                for (int i = 0; i < mutation.count; i++)
+                    copy.addVolunteer(mutation.volunteer);
+            }
+            else if (mutation.kind == MutationKind::ORDERS)
+            {
+                if (mutation.customerId >= copy.getCustomerCounter())
+                {
+                    throw std::invalid_argument("No customer " + std::to_string(mutation.customerId));
+                }
+                Customer *customer = copy.getCustomers()[mutation.customerId]; // Indexed by id
+                for (int i = 0; i < mutation.count; i++)
+                {
+                    if (!copy.placeOrder(*customer))
+                        break;
+                }
+            }
+        }
+    }
+
+    std::atomic<size_t> next(0);
+    auto worker = [&]()
+    {
+        for (size_t i = next++; i < runs.size(); i = next++)
+        {
+            evaluate(*copies[i], runs[i]);
+        }
+    };
+    size_t threadCount = std::min<size_t>(runs.size(), std::max(1u, std::thread::hardware_concurrency()));
+    vector<std::thread> threads;
+    for (size_t i = 1; i < threadCount; i++)
+    {
+        threads.emplace_back(worker);
+    }
+    worker();
+    for (std::thread &thread : threads)
+    {
+        thread.join();
+    }
+}
+
+void ScenarioRunner::evaluate(WareHouse &copy, Run &run) const
+{
+    const int start = copy.getCurrentTick();
+    const int firstPlaced = copy.getOrderCounter(); // Orders from here on were placed by demand
+    vector<int> placedAt;                          // By order id - firstPlaced
+
+    // Each demand goes round the matching customers that can still order
+    struct Demand
+    {
+        int perTick;
+        vector<Customer *> customers;
+        size_t next;
+    };
+    vector<Demand> demands;
+    for (const Mutation &mutation : run.scenario.mutations)
+    {
+        if (mutation.kind != MutationKind::DEMAND)
+            continue;
+        Demand demand = {mutation.count, {}, 0};
+        for (Customer *customer : copy.getCustomers())
+        {
+            if (matchesType(customer, mutation.customerType))
+                demand.customers.push_back(customer);
+        }
+        demands.push_back(demand);
+    }
+
+    ScenarioResult &result = run.result;
+    for (int tick = 0; tick < horizon; tick++)
+    {
+        for (Demand &demand : demands)
+        {
+            for (int placed = 0; placed < demand.perTick && !demand.customers.empty();)
+            {
+                demand.next %= demand.customers.size();
+                if (copy.placeOrder(*demand.customers[demand.next]))
+                {
+                    placedAt.push_back(copy.getCurrentTick());
+                    placed++;
+                    demand.next++;
+                }
+                else
+                {
+                    demand.customers.erase(demand.customers.begin() + demand.next);
+                }
+            }
+        }
+        copy.simulateStep(1);
+        const TickCounts &counts = copy.getThroughput().getLastTick();
+        result.busyVolunteerTicks += counts.busyVolunteers;
+        result.volunteerTicks += counts.volunteers;
+    }
+
+    vector<int> latencies;
+    OrderArchive::Cursor cursor(copy.getCompletedOrders());
+    ArchivedOrder order;
+    while (cursor.next(order))
+    {
+        if (order.completedTick < start)
+            continue;
+        int placed = order.id >= firstPlaced ? placedAt[order.id - firstPlaced] : start;
+        latencies.push_back(order.completedTick - placed + 1);
+    }
+    result.completed = static_cast<int>(latencies.size());
+    result.open = static_cast<int>(copy.getPendingOrders().size() + copy.getInProcessOrders().size());
+    for (int latency : latencies)
+    {
+        result.latencySum += latency;
+        result.maxLatency = std::max(result.maxLatency, latency);
+    }
+    if (!latencies.empty())
+    {
+        size_t rank = (latencies.size() * 95 + 99) / 100 - 1;
+        std::nth_element(latencies.begin(), latencies.begin() + rank, latencies.end());
+        result.p95Latency = latencies[rank];
+    }
+}
+
+static void appendCell(string &buffer, const string &text, size_t width)
+{
+    appendText(buffer, text);
+    if (text.size() < width)
+        buffer.append(width - text.size(), ' ');
+}
+
+static void appendNumber(string &buffer, long long value, size_t width)
+{
+    string text;
+    appendInt(text, value);
+    if (text.size() < width)
+        buffer.append(width - text.size(), ' ');
+    appendText(buffer, text);
+}
+
+// numerator / denominator with two decimals, right-aligned
+static void appendRatio(string &buffer, long long numerator, long long denominator, size_t width)
+{
+    long long hundredths = denominator == 0 ? 0 : numerator * 100 / denominator;
+    string text;
+    appendInt(text, hundredths / 100);
+    text += '.';
+    if (hundredths % 100 < 10)
+        text += '0';
+    appendInt(text, hundredths % 100);
+    if (text.size() < width)
+        buffer.append(width - text.size(), ' ');
+    appendText(buffer, text);
+}
+
+void ScenarioRunner::appendTable(string &buffer) const
+{
+    appendText(buffer, "Horizon: ");
+    appendInt(buffer, horizon);
+    appendText(buffer, " ticks from tick ");
+    appendInt(buffer, wareHouse.getCurrentTick());
+    buffer += '\n';
+    appendCell(buffer, "Scenario", SCENARIO_NAME_WIDTH);
+    appendText(buffer, " Completed      Open  Mean latency  P95 latency  Max latency  Utilization%\n");
+    for (const Run &run : runs)
+    {
+        const ScenarioResult &result = run.result;
+        string name = run.scenario.name;
+        if (name.size() > SCENARIO_NAME_WIDTH)
+            name = name.substr(0, SCENARIO_NAME_WIDTH - 3) + "...";
+        appendCell(buffer, name, SCENARIO_NAME_WIDTH);
+        appendNumber(buffer, result.completed, 10);
+        appendNumber(buffer, result.open, 10);
+        appendRatio(buffer, result.latencySum, result.completed, 14);
+        appendNumber(buffer, result.p95Latency, 13);
+        appendNumber(buffer, result.maxLatency, 13);
+        appendRatio(buffer, result.busyVolunteerTicks * 100, result.volunteerTicks, 14);
+        buffer += '\n';
+    }
+}
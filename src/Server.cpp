@@ -0,0 +1,508 @@
+#include "../include/Server.h"
+#include "../include/OutputSink.h"
+
+#include <cerrno>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <iterator>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+#include <fcntl.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+Server::Server(WareHouse &wareHouse, const string &socketPath)
+    : wareHouse(wareHouse), socketPath(socketPath), listenFd(-1), epollFd(-1), wakeFd(-1), connections(), producerFds(), nextSerial(0),
+      publisher(), simulation(), jobsMutex(), jobsReady(), jobs(), results(), intakeResults(), closed(false)
+{
+    sockaddr_un address;
+    std::memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    if (socketPath.size() >= sizeof(address.sun_path))
+    {
+        throw std::invalid_argument("Socket path too long: " + socketPath);
+    }
+    std::strcpy(address.sun_path, socketPath.c_str());
+
+    listenFd = ::socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (listenFd < 0)
+    {
+        throw std::runtime_error("Could not create socket: " + string(std::strerror(errno)));
+    }
+    ::unlink(socketPath.c_str());
+    if (::bind(listenFd, reinterpret_cast<sockaddr *>(&address), sizeof(address)) < 0 || ::listen(listenFd, SOMAXCONN) < 0)
+    {
+        ::close(listenFd);
+        throw std::runtime_error("Could not listen on " + socketPath + ": " + std::strerror(errno));
+    }
+
+    epollFd = ::epoll_create1(EPOLL_CLOEXEC);
+    wakeFd = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    epoll_event event;
+    std::memset(&event, 0, sizeof(event));
+    event.events = EPOLLIN;
+    event.data.fd = listenFd;
+    bool ready = epollFd >= 0 && wakeFd >= 0 && ::epoll_ctl(epollFd, EPOLL_CTL_ADD, listenFd, &event) == 0;
+    event.data.fd = wakeFd;
+    if (!ready || ::epoll_ctl(epollFd, EPOLL_CTL_ADD, wakeFd, &event) < 0)
+    {
+        ::close(listenFd);
+        throw std::runtime_error("Could not set up epoll: " + string(std::strerror(errno)));
+    }
+}
+
+Server::~Server()
+{
+    // Stop the simulation thread if run() left early
+    if (simulation.joinable())
+    {
+        {
+            std::lock_guard<std::mutex> lock(jobsMutex);
+            closed = true;
+        }
+        jobsReady.notify_one();
+        simulation.join();
+    }
+    {
+        std::unique_lock<std::mutex> tickBoundary = wareHouse.holdClock();
+        wareHouse.setPublisher(nullptr);
+        wareHouse.setStepsDrainIntake(true);
+    }
+    for (auto &connection : connections)
+    {
+        ::close(connection.first);
+    }
+    connections.clear();
+    ::close(wakeFd);
+    ::close(epollFd);
+    ::close(listenFd);
+    ::unlink(socketPath.c_str());
+}
+
+void Server::run()
+{
+    // Queries that arrive before the first command still need a version to read
+    {
+        std::unique_lock<std::mutex> tickBoundary = wareHouse.holdClock();
+        publisher.publish(wareHouse);
+        wareHouse.setPublisher(&publisher);
+        // Only the batch boundary drains, where every request's outcome goes back to its client
+        wareHouse.setStepsDrainIntake(false);
+    }
+    simulation = std::thread(&Server::simulate, this);
+
+    epoll_event events[SERVER_MAX_EVENTS];
+    bool open = true;
+    while (open)
+    {
+        int ready = ::epoll_wait(epollFd, events, SERVER_MAX_EVENTS, -1);
+        if (ready < 0)
+        {
+            if (errno == EINTR)
+                continue;
+            throw std::runtime_error("epoll_wait failed: " + string(std::strerror(errno)));
+        }
+
+        for (int i = 0; i < ready; i++)
+        {
+            int fd = events[i].data.fd;
+            if (fd == listenFd)
+            {
+                acceptClients();
+                continue;
+            }
+            if (fd == wakeFd)
+            {
+                collectResults();
+                std::lock_guard<std::mutex> lock(jobsMutex);
+                open = !closed;
+                continue;
+            }
+            auto found = connections.find(fd);
+            if (found == connections.end())
+            {
+                continue;
+            }
+            // The peer is gone in both directions and has nothing left to send
+            if ((events[i].events & (EPOLLHUP | EPOLLERR)) && found->second.peerClosed)
+            {
+                closeConnection(fd);
+                continue;
+            }
+            if (events[i].events & (EPOLLIN | EPOLLHUP | EPOLLERR))
+            {
+                readFrom(fd);
+            }
+            if ((events[i].events & EPOLLOUT) && connections.count(fd))
+            {
+                writeTo(fd);
+            }
+        }
+    }
+    simulation.join();
+
+    // Deliver what is left, including the close report, before shutting down
+    for (auto &connection : connections)
+    {
+        if (!connection.second.output.empty())
+        {
+            int flags = ::fcntl(connection.first, F_GETFL);
+            ::fcntl(connection.first, F_SETFL, flags & ~O_NONBLOCK);
+            writeTo(connection.first);
+        }
+    }
+}
+
+void Server::acceptClients()
+{
+    while (true)
+    {
+        int fd = ::accept4(listenFd, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if (fd < 0)
+        {
+            return; // EAGAIN once the backlog is empty
+        }
+        epoll_event event;
+        std::memset(&event, 0, sizeof(event));
+        event.events = EPOLLIN;
+        event.data.fd = fd;
+        ::epoll_ctl(epollFd, EPOLL_CTL_ADD, fd, &event);
+        Connection &connection = connections.emplace(fd, Connection(wareHouse.getIntake().makeProducer())).first->second;
+        connection.serial = ++nextSerial;
+        producerFds[connection.producer.getId()] = fd;
+    }
+}
+
+void Server::readFrom(int fd)
+{
+    auto found = connections.find(fd);
+    if (found == connections.end())
+    {
+        return;
+    }
+    Connection &connection = found->second;
+    char buffer[SERVER_READ_SIZE];
+    bool peerClosed = false;
+    while (true)
+    {
+        ssize_t received = ::read(fd, buffer, sizeof(buffer));
+        if (received > 0)
+        {
+            connection.input.append(buffer, received);
+            continue;
+        }
+        if (received < 0 && errno == EINTR)
+            continue;
+        peerClosed = received == 0 || (errno != EAGAIN && errno != EWOULDBLOCK);
+        break;
+    }
+
+    if (peerClosed)
+    {
+        connection.peerClosed = true;
+        updateInterest(fd);
+    }
+    processLines(fd);
+}
+
+// Answers queries in place and hands the first other command to the simulation thread,
+// through the intake if it places an order or adds a customer; the lines after it wait
+// until its response is back
+void Server::processLines(int fd)
+{
+    Connection &connection = connections.at(fd);
+    size_t lineStart = 0;
+    size_t lineEnd;
+    string line;
+    while (!connection.waiting && (lineEnd = connection.input.find('\n', lineStart)) != string::npos)
+    {
+        line.assign(connection.input, lineStart, lineEnd - lineStart);
+        if (!line.empty() && line.back() == '\r')
+        {
+            line.pop_back();
+        }
+        lineStart = lineEnd + 1;
+
+        if (answerQuery(line, connection.output))
+        {
+            connection.output += RESPONSE_END;
+            continue;
+        }
+        connection.waiting = true;
+        if (submitIntake(line, connection))
+        {
+            continue;
+        }
+        {
+            std::lock_guard<std::mutex> lock(jobsMutex);
+            jobs.push_back(Job{fd, connection.serial, line, string()});
+        }
+        jobsReady.notify_one();
+    }
+    connection.input.erase(0, lineStart);
+
+    writeTo(fd);
+    if (connections.count(fd) && connection.peerClosed && !connection.waiting)
+    {
+        closeConnection(fd);
+    }
+}
+
+// Parses "<command> <id>" the way WareHouse::execute does
+static bool parseQuery(const string &line, const char *command, int &id)
+{
+    size_t length = std::strlen(command);
+    return line.compare(0, length, command) == 0 && line.size() > length && line[length] == ' ' &&
+           std::sscanf(line.c_str() + length + 1, "%d", &id) == 1;
+}
+
+// Read-only queries are not added to the action log, unlike their stdin counterparts
+bool Server::answerQuery(const string &line, string &response) const
+{
+    int id;
+    if (line == "log")
+    {
+        publisher.current()->log(response);
+    }
+    else if (parseQuery(line, "orderStatus", id))
+    {
+        if (!publisher.current()->orderStatus(id, response))
+            response += "Error: Order doesnt exist\n";
+    }
+    else if (parseQuery(line, "customerStatus", id))
+    {
+        if (!publisher.current()->customerStatus(id, response))
+            response += "Error: Customer doesnt exist\n";
+    }
+    else if (parseQuery(line, "volunteerStatus", id))
+    {
+        if (!publisher.current()->volunteerStatus(id, response))
+            response += "Error: Volunteer doesnt exist\n";
+    }
+    else
+    {
+        return false;
+    }
+    return true;
+}
+
+// Lines that parse as "order <customer_id>" or "customer <name> <type> <distance> <max_orders>"
+// go into the intake; anything else, malformed ones included, runs as a job so that it
+// gets the same error as on stdin
+bool Server::submitIntake(const string &line, Connection &connection)
+{
+    std::istringstream words(line);
+    string command;
+    string name;
+    string customerType;
+    int first = 0;
+    int distance = 0;
+    int maxOrders = 0;
+    char extra = 0;
+    words >> command;
+    if (command == "order" && words >> first && !(words >> extra))
+    {
+        connection.producer.submitOrder(first);
+    }
+    else if (command == "customer" && words >> name >> customerType >> distance >> maxOrders && !(words >> extra))
+    {
+        connection.producer.submitCustomer(name, customerType, distance, maxOrders);
+    }
+    else
+    {
+        return false;
+    }
+    // Taking the lock orders the push before the simulation thread's next look at the
+    // intake, so the wakeup cannot fall between its check and its wait
+    {
+        std::lock_guard<std::mutex> lock(jobsMutex);
+    }
+    jobsReady.notify_one();
+    return true;
+}
+
+// Hands finished commands back to their connections, which may then continue
+void Server::collectResults()
+{
+    uint64_t signals;
+    while (::read(wakeFd, &signals, sizeof(signals)) < 0 && errno == EINTR)
+    {
+    }
+
+    std::deque<Job> finished;
+    std::deque<IntakeOutcome> applied;
+    {
+        std::lock_guard<std::mutex> lock(jobsMutex);
+        finished.swap(results);
+        applied.swap(intakeResults);
+    }
+    for (IntakeOutcome &outcome : applied)
+    {
+        auto producer = producerFds.find(outcome.producerId);
+        if (producer == producerFds.end())
+        {
+            continue; // The client left before its request was applied
+        }
+        Connection &connection = connections.at(producer->second);
+        connection.output += outcome.printed;
+        connection.output += RESPONSE_END;
+        connection.waiting = false;
+        processLines(producer->second);
+    }
+    for (Job &job : finished)
+    {
+        auto found = connections.find(job.fd);
+        if (found == connections.end() || found->second.serial != job.serial)
+        {
+            continue; // The client left before its response was ready
+        }
+        found->second.output += job.response;
+        found->second.waiting = false;
+        processLines(job.fd);
+    }
+}
+
+// The only thread that touches the WareHouse once run() started
+void Server::simulate()
+{
+    std::unique_lock<std::mutex> lock(jobsMutex);
+    while (!closed)
+    {
+        jobsReady.wait_for(lock, std::chrono::milliseconds(SERVER_IDLE_WAIT_MS), [this]
+                           { return !jobs.empty() || !wareHouse.getIntake().empty() || closed; });
+        std::deque<Job> batch;
+        batch.swap(jobs);
+        lock.unlock();
+
+        // Requests submitted by producers go in before this batch of commands, and are
+        // answered once the version showing them is published
+        std::unique_lock<std::mutex> tickBoundary = wareHouse.holdClock();
+        vector<IntakeOutcome> outcomes;
+        if (wareHouse.drainIntake(&outcomes) > 0)
+        {
+            publisher.publish(wareHouse);
+        }
+        tickBoundary = std::unique_lock<std::mutex>(); // Empty when no clock runs, unlock() would throw
+        if (!outcomes.empty())
+        {
+            {
+                std::lock_guard<std::mutex> resultLock(jobsMutex);
+                intakeResults.insert(intakeResults.end(), std::make_move_iterator(outcomes.begin()), std::make_move_iterator(outcomes.end()));
+            }
+            uint64_t one = 1;
+            ::write(wakeFd, &one, sizeof(one));
+        }
+
+        for (Job &job : batch)
+        {
+            tickBoundary = wareHouse.holdClock();
+            if (!wareHouse.isOpened())
+            {
+                break;
+            }
+            // After "report <path>" responses go to the file, as on stdin
+            bool capture = !output.isRedirected();
+            if (capture)
+                output.beginCapture(job.response);
+            try
+            {
+                if (!wareHouse.execute(job.line))
+                {
+                    output << "Invalid input!\n";
+                }
+            }
+            catch (const std::exception &)
+            {
+                output << "Invalid input!\n";
+            }
+            output.endCapture();
+            if (!capture)
+                output.flush();
+            job.response += RESPONSE_END;
+            publisher.publish(wareHouse);
+            tickBoundary = std::unique_lock<std::mutex>();
+
+            {
+                std::lock_guard<std::mutex> resultLock(jobsMutex);
+                results.push_back(std::move(job));
+            }
+            uint64_t one = 1;
+            ::write(wakeFd, &one, sizeof(one));
+        }
+
+        tickBoundary = wareHouse.holdClock();
+        bool isOpen = wareHouse.isOpened();
+        tickBoundary = std::unique_lock<std::mutex>();
+
+        lock.lock();
+        if (!isOpen)
+        {
+            closed = true;
+            uint64_t one = 1;
+            ::write(wakeFd, &one, sizeof(one));
+        }
+    }
+}
+
+void Server::writeTo(int fd)
+{
+    auto found = connections.find(fd);
+    if (found == connections.end())
+    {
+        return;
+    }
+    Connection &connection = found->second;
+    size_t sent = 0;
+    while (sent < connection.output.size())
+    {
+        ssize_t written = ::send(fd, connection.output.data() + sent, connection.output.size() - sent, MSG_NOSIGNAL);
+        if (written < 0)
+        {
+            if (errno == EINTR)
+                continue;
+            if (errno == EAGAIN || errno == EWOULDBLOCK)
+                break;
+            closeConnection(fd);
+            return;
+        }
+        sent += written;
+    }
+    connection.output.erase(0, sent);
+    updateInterest(fd);
+}
+
+// Only ask for EPOLLOUT while a response is waiting on a full socket buffer,
+// and stop asking for EPOLLIN once the peer is done sending
+void Server::updateInterest(int fd)
+{
+    Connection &connection = connections.at(fd);
+    uint32_t interest = (connection.peerClosed ? 0 : EPOLLIN) | (connection.output.empty() ? 0 : EPOLLOUT);
+    if (connection.interest == interest)
+    {
+        return;
+    }
+    connection.interest = interest;
+    epoll_event event;
+    std::memset(&event, 0, sizeof(event));
+    event.events = interest;
+    event.data.fd = fd;
+    ::epoll_ctl(epollFd, EPOLL_CTL_MOD, fd, &event);
+}
+
+void Server::closeConnection(int fd)
+{
+    ::epoll_ctl(epollFd, EPOLL_CTL_DEL, fd, nullptr);
+    ::close(fd);
+    auto found = connections.find(fd);
+    if (found != connections.end())
+    {
+        producerFds.erase(found->second.producer.getId());
+        connections.erase(found);
+    }
+}
@@ -0,0 +1,151 @@
+#include "../include/SimulationClock.h"
+#include "../include/WareHouse.h"
+#include "../include/Format.h"
+
+#include <algorithm>
+#include <iostream>
+#include <stdexcept>
+
+using std::chrono::microseconds;
+using std::chrono::steady_clock;
+
+SimulationClock::SimulationClock(WareHouse &wareHouse, int ticksPerSecond)
+    : wareHouse(wareHouse), ticksPerSecond(ticksPerSecond), driver(), tickMutex(), stopped(), running(false), waiting(0),
+      ticks(0), overruns(0), skippedTicks(0), worstTickMicros(0), unreportedOverruns(0), unreportedWorstMicros(0), lastWarning()
+{
+    if (ticksPerSecond < 0)
+    {
+        throw std::invalid_argument("Tick rate must not be negative");
+    }
+}
+
+SimulationClock::~SimulationClock()
+{
+    stop();
+}
+
+void SimulationClock::start()
+{
+    if (running)
+    {
+        return;
+    }
+    running = true;
+    lastWarning = steady_clock::now();
+    driver = std::thread(&SimulationClock::run, this);
+}
+
+void SimulationClock::stop()
+{
+    {
+        std::lock_guard<std::mutex> lock(tickMutex);
+        running = false;
+    }
+    stopped.notify_all();
+    if (driver.joinable())
+    {
+        driver.join();
+    }
+}
+
+std::unique_lock<std::mutex> SimulationClock::holdTick()
+{
+    waiting++;
+    std::unique_lock<std::mutex> lock(tickMutex);
+    waiting--;
+    return lock;
+}
+
+void SimulationClock::appendReport(string &buffer) const
+{
+    appendText(buffer, "Tick rate: ");
+    if (ticksPerSecond == CLOCK_AS_FAST_AS_POSSIBLE)
+    {
+        appendText(buffer, "as fast as possible");
+    }
+    else
+    {
+        appendInt(buffer, ticksPerSecond);
+        appendText(buffer, "/s");
+    }
+    appendText(buffer, "\nTicks: ");
+    appendInt(buffer, ticks);
+    appendText(buffer, "\nOverruns: ");
+    appendInt(buffer, overruns);
+    appendText(buffer, "\nSkipped ticks: ");
+    appendInt(buffer, skippedTicks);
+    appendText(buffer, "\nWorst tick: ");
+    appendInt(buffer, worstTickMicros);
+    appendText(buffer, " us\n");
+}
+
+void SimulationClock::run()
+{
+    microseconds budget(ticksPerSecond == CLOCK_AS_FAST_AS_POSSIBLE ? 0 : 1000000 / ticksPerSecond);
+    steady_clock::time_point deadline = steady_clock::now();
+    while (running)
+    {
+        // A command is waiting for the tick boundary, let it in before the next tick
+        if (waiting > 0)
+        {
+            std::this_thread::yield();
+            continue;
+        }
+        tick(budget);
+        warnOverruns(budget);
+        if (budget.count() == 0)
+        {
+            continue;
+        }
+
+        // Skip the ticks an overrun made us miss instead of running them back to back
+        std::unique_lock<std::mutex> lock(tickMutex);
+        deadline += budget;
+        steady_clock::time_point now = steady_clock::now();
+        if (now > deadline)
+        {
+            long long missed = (now - deadline) / budget;
+            skippedTicks += missed;
+            deadline += missed * budget;
+            continue;
+        }
+        stopped.wait_until(lock, deadline, [this]
+                           { return !running; });
+    }
+}
+
+void SimulationClock::tick(microseconds budget)
+{
+    std::lock_guard<std::mutex> lock(tickMutex);
+    if (!wareHouse.isOpened())
+    {
+        running = false;
+        return;
+    }
+    steady_clock::time_point begin = steady_clock::now();
+    wareHouse.simulateStep(1);
+    long long took = std::chrono::duration_cast<microseconds>(steady_clock::now() - begin).count();
+
+    ticks++;
+    worstTickMicros = std::max(worstTickMicros, took);
+    if (budget.count() > 0 && took > budget.count())
+    {
+        overruns++;
+        unreportedOverruns++;
+        unreportedWorstMicros = std::max(unreportedWorstMicros, took);
+    }
+}
+
+void SimulationClock::warnOverruns(microseconds budget)
+{
+    steady_clock::time_point now = steady_clock::now();
+    if (unreportedOverruns == 0 || now - lastWarning < std::chrono::milliseconds(CLOCK_WARNING_INTERVAL_MS))
+    {
+        return;
+    }
+    std::cerr << "Clock: " << unreportedOverruns << " ticks overran their " << budget.count()
+              << " us budget (worst " << unreportedWorstMicros << " us)" << std::endl;
+    unreportedOverruns = 0;
+    unreportedWorstMicros = 0;
+    lastWarning = now;
+}
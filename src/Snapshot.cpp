@@ -0,0 +1,255 @@
+#include "../include/Snapshot.h"
+#include "../include/WareHouse.h"
+#include "../include/Volunteer.h"
+#include "../include/Action.h"
+#include "../include/Format.h"
+
+#include <algorithm>
+
+// Snapshot implementation
+
+Snapshot::Snapshot() : tick(0), liveOrders(), completedOrders(), volunteers(), customers(), logChunks() {}
+
+int Snapshot::getTick() const
+{
+    return tick;
+}
+
+void Snapshot::appendOrderStatus(string &buffer, int orderId, OrderStatus status, int customerId, int collectorId, int driverId)
+{
+    appendText(buffer, "OrderId: ");
+    appendInt(buffer, orderId);
+    appendText(buffer, "\nOrderStatus: ");
+    appendText(buffer, Order::getStatusString(status));
+    appendText(buffer, "\nCustomerID: ");
+    appendInt(buffer, customerId);
+    appendText(buffer, "\nCollector: ");
+    if (collectorId == NO_VOLUNTEER)
+        appendText(buffer, "None");
+    else
+        appendInt(buffer, collectorId);
+    appendText(buffer, "\nDriver: ");
+    if (driverId == NO_VOLUNTEER)
+        appendText(buffer, "None");
+    else
+        appendInt(buffer, driverId);
+    buffer += '\n';
+}
+
+void Snapshot::appendOrderLine(string &buffer, int orderId, OrderStatus status)
+{
+    appendText(buffer, "OrderID: ");
+    appendInt(buffer, orderId);
+    appendText(buffer, "\nOrderStatus: ");
+    appendText(buffer, Order::getStatusString(status));
+    buffer += '\n';
+}
+
+void Snapshot::appendVolunteerStatus(string &buffer, const VolunteerRecord &volunteer)
+{
+    bool busy = volunteer.activeOrderId != NO_ORDER;
+    appendText(buffer, "VolunteerID: ");
+    appendInt(buffer, volunteer.id);
+    appendText(buffer, busy ? "\nisBusy: True\n" : "\nisBusy: False\n");
+    if (busy)
+    {
+        appendText(buffer, "OrderID: ");
+        appendInt(buffer, volunteer.activeOrderId);
+        appendText(buffer, "\nTimeLeft: ");
+        appendInt(buffer, volunteer.timeLeft);
+        buffer += '\n';
+    }
+    else
+    {
+        appendText(buffer, "OrderID: None\nTimeLeft: None\n");
+    }
+    if (volunteer.ordersLeft == NO_LIMIT)
+    {
+        appendText(buffer, "OrdersLeft: No limit\n");
+    }
+    else
+    {
+        appendText(buffer, "OrdersLeft: ");
+        appendInt(buffer, volunteer.ordersLeft);
+        buffer += '\n';
+    }
+}
+
+bool Snapshot::findOrderStatus(int orderId, OrderStatus &status) const
+{
+    auto found = std::lower_bound(liveOrders.begin(), liveOrders.end(), orderId, [](const Order &order, int id)
+                                  { return order.getId() < id; });
+    if (found != liveOrders.end() && found->getId() == orderId)
+    {
+        status = found->getStatus();
+        return true;
+    }
+    ArchivedOrder archived;
+    if (completedOrders.find(orderId, archived))
+    {
+        status = OrderStatus::COMPLETED;
+        return true;
+    }
+    return false;
+}
+
+bool Snapshot::orderStatus(int orderId, string &buffer) const
+{
+    auto found = std::lower_bound(liveOrders.begin(), liveOrders.end(), orderId, [](const Order &order, int id)
+                                  { return order.getId() < id; });
+    if (found != liveOrders.end() && found->getId() == orderId)
+    {
+        appendOrderStatus(buffer, orderId, found->getStatus(), found->getCustomerId(), found->getCollectorId(), found->getDriverId());
+        return true;
+    }
+    ArchivedOrder archived;
+    if (completedOrders.find(orderId, archived))
+    {
+        appendOrderStatus(buffer, orderId, OrderStatus::COMPLETED, archived.customerId, archived.collectorId, archived.driverId);
+        return true;
+    }
+    return false;
+}
+
+bool Snapshot::customerStatus(int customerId, string &buffer) const
+{
+    for (const auto &customer : customers)
+    {
+        if (customer->id != customerId)
+        {
+            continue;
+        }
+        appendText(buffer, "CustomerID: ");
+        appendInt(buffer, customerId);
+        buffer += '\n';
+        for (int orderId : customer->orderIds)
+        {
+            OrderStatus status = OrderStatus::PENDING;
+            findOrderStatus(orderId, status);
+            appendOrderLine(buffer, orderId, status);
+        }
+        appendText(buffer, "numOrdersLeft: ");
+        appendInt(buffer, customer->maxOrders - static_cast<int>(customer->orderIds.size()));
+        buffer += '\n';
+        return true;
+    }
+    return false;
+}
+
+bool Snapshot::volunteerStatus(int volunteerId, string &buffer) const
+{
+    for (const VolunteerRecord &volunteer : volunteers)
+    {
+        if (volunteer.id == volunteerId)
+        {
+            appendVolunteerStatus(buffer, volunteer);
+            return true;
+        }
+    }
+    return false;
+}
+
+void Snapshot::log(string &buffer) const
+{
+    for (const auto &chunk : logChunks)
+    {
+        buffer += *chunk;
+    }
+}
+
+// SnapshotPublisher implementation
+
+SnapshotPublisher::SnapshotPublisher()
+    : latest(std::make_shared<const Snapshot>()), customers(), logChunks(), openChunk(), openChunkLines(0), loggedActions(0), restoreCount(0), publishedAt(), publishCost() {}
+
+std::shared_ptr<const Snapshot> SnapshotPublisher::current() const
+{
+    return std::atomic_load(&latest);
+}
+
+void SnapshotPublisher::publish(const WareHouse &wareHouse)
+{
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    std::shared_ptr<Snapshot> snapshot = std::make_shared<Snapshot>();
+    snapshot->tick = wareHouse.getCurrentTick();
+
+    // The table keeps its orders by id, the snapshot needs no sort
+    const OrderTable &liveOrders = wareHouse.getLiveOrders();
+    snapshot->liveOrders.reserve(liveOrders.size());
+    liveOrders.appendLive(snapshot->liveOrders);
+    snapshot->completedOrders = wareHouse.getCompletedOrders();
+
+    for (const Volunteer *volunteer : wareHouse.getVolunteers())
+    {
+        snapshot->volunteers.push_back(wareHouse.getVolunteerRecord(volunteer));
+    }
+
+    // A restore replaced the whole state, nothing cached can be reused
+    if (wareHouse.getRestoreCount() != restoreCount)
+    {
+        restoreCount = wareHouse.getRestoreCount();
+        customers.clear();
+        logChunks.clear();
+        openChunk.clear();
+        openChunkLines = 0;
+        loggedActions = 0;
+    }
+    updateCustomers(wareHouse);
+    updateLog(wareHouse);
+    snapshot->customers = customers;
+    snapshot->logChunks = logChunks;
+    if (openChunkLines > 0)
+    {
+        snapshot->logChunks.push_back(std::make_shared<const string>(openChunk));
+    }
+
+    std::atomic_store(&latest, std::shared_ptr<const Snapshot>(std::move(snapshot)));
+    publishedAt = std::chrono::steady_clock::now();
+    publishCost = publishedAt - start;
+}
+
+// A step takes far less than a publish, so a long run only publishes every
+// SNAPSHOT_MIN_INTERVAL_US, or less often when a large backlog makes a publish
+// expensive; readers still see it advance in real time
+void SnapshotPublisher::publishIfStale(const WareHouse &wareHouse)
+{
+    std::chrono::steady_clock::duration interval = std::max<std::chrono::steady_clock::duration>(
+        std::chrono::microseconds(SNAPSHOT_MIN_INTERVAL_US), publishCost * SNAPSHOT_COST_FACTOR);
+    if (std::chrono::steady_clock::now() - publishedAt >= interval)
+    {
+        publish(wareHouse);
+    }
+}
+
+// Only customers who placed orders since the last version get a new record
+void SnapshotPublisher::updateCustomers(const WareHouse &wareHouse)
+{
+    const vector<Customer *> &list = wareHouse.getCustomers();
+    customers.resize(list.size());
+    for (size_t i = 0; i < list.size(); i++)
+    {
+        const Customer *customer = list[i];
+        const auto &record = customers[i];
+        if (record == nullptr || record->id != customer->getId() || record->orderIds.size() != customer->getOrdersIds().size())
+        {
+            customers[i] = std::make_shared<const CustomerRecord>(CustomerRecord{customer->getId(), customer->getMaxOrders(), customer->getOrdersIds()});
+        }
+    }
+}
+
+// Log lines are rendered once; full chunks are shared by every later version
+void SnapshotPublisher::updateLog(const WareHouse &wareHouse)
+{
+    const ActionLog &actions = wareHouse.getActions();
+    for (size_t i = loggedActions; i < actions.size(); i++)
+    {
+        actions.appendLine(i, openChunk);
+        if (++openChunkLines == LOG_CHUNK_LINES)
+        {
+            logChunks.push_back(std::make_shared<const string>(std::move(openChunk)));
+            openChunk.clear();
+            openChunkLines = 0;
+        }
+    }
+    loggedActions = actions.size();
+}
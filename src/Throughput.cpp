@@ -0,0 +1,112 @@
+#include "../include/Throughput.h"
+#include "../include/Format.h"
+
+#include <algorithm>
+
+const int ThroughputMeter::windowSizes[THROUGHPUT_WINDOWS] = {10, 100, THROUGHPUT_HISTORY};
+
+ThroughputMeter::ThroughputMeter() : current(), history(THROUGHPUT_HISTORY), ticks(0), sums() {}
+
+void ThroughputMeter::orderCreated()
+{
+    current.created++;
+}
+
+void ThroughputMeter::orderCollected()
+{
+    current.collected++;
+}
+
+void ThroughputMeter::orderDelivered()
+{
+    current.delivered++;
+}
+
+void ThroughputMeter::endTick(int busyVolunteers, int volunteers)
+{
+    current.busyVolunteers = busyVolunteers;
+    current.volunteers = volunteers;
+    for (int i = 0; i < THROUGHPUT_WINDOWS; i++)
+    {
+        TickCounts &sum = sums[i];
+        sum.created += current.created;
+        sum.collected += current.collected;
+        sum.delivered += current.delivered;
+        sum.busyVolunteers += current.busyVolunteers;
+        sum.volunteers += current.volunteers;
+        if (ticks >= windowSizes[i])
+        {
+            // The tick that falls out of this window
+            const TickCounts &old = history[(ticks - windowSizes[i]) % THROUGHPUT_HISTORY];
+            sum.created -= old.created;
+            sum.collected -= old.collected;
+            sum.delivered -= old.delivered;
+            sum.busyVolunteers -= old.busyVolunteers;
+            sum.volunteers -= old.volunteers;
+        }
+    }
+    history[ticks % THROUGHPUT_HISTORY] = current;
+    ticks++;
+    current = TickCounts();
+}
+
+const TickCounts &ThroughputMeter::getWindow(int window) const
+{
+    return sums[window];
+}
+
+const TickCounts &ThroughputMeter::getLastTick() const
+{
+    // Before the first tick this slot is still zeros
+    return history[(ticks + THROUGHPUT_HISTORY - 1) % THROUGHPUT_HISTORY];
+}
+
+int ThroughputMeter::getWindowTicks(int window) const
+{
+    return static_cast<int>(std::min<long long>(ticks, windowSizes[window]));
+}
+
+// numerator / denominator with two decimals
+static void appendRatio(string &buffer, long long numerator, long long denominator)
+{
+    if (denominator == 0)
+    {
+        appendText(buffer, "0.00");
+        return;
+    }
+    long long hundredths = numerator * 100 / denominator;
+    if (hundredths < 0)
+    {
+        buffer += '-';
+        hundredths = -hundredths;
+    }
+    appendInt(buffer, hundredths / 100);
+    buffer += '.';
+    if (hundredths % 100 < 10)
+        buffer += '0';
+    appendInt(buffer, hundredths % 100);
+}
+
+void ThroughputMeter::appendReport(string &buffer) const
+{
+    for (int i = 0; i < THROUGHPUT_WINDOWS; i++)
+    {
+        const TickCounts &sum = sums[i];
+        int windowTicks = getWindowTicks(i);
+        appendText(buffer, "Last ");
+        appendInt(buffer, windowSizes[i]);
+        appendText(buffer, " ticks (");
+        appendInt(buffer, windowTicks);
+        appendText(buffer, " run): Created: ");
+        appendRatio(buffer, sum.created, windowTicks);
+        appendText(buffer, "/tick, Collected: ");
+        appendRatio(buffer, sum.collected, windowTicks);
+        appendText(buffer, "/tick, Delivered: ");
+        appendRatio(buffer, sum.delivered, windowTicks);
+        appendText(buffer, "/tick, Backlog growth: ");
+        appendRatio(buffer, sum.created - sum.delivered, windowTicks);
+        appendText(buffer, "/tick, Utilization: ");
+        appendRatio(buffer, sum.busyVolunteers * 100, sum.volunteers);
+        appendText(buffer, "%\n");
+    }
+}
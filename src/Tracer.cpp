@@ -0,0 +1,201 @@
+#include "../include/Tracer.h"
+#include "../include/Format.h"
+#include "../include/Volunteer.h"
+
+#include <chrono>
+#include <set>
+#include <fcntl.h>
+#include <unistd.h>
+
+#define TRACE_WAREHOUSE_PID 1  // Threads of the warehouse
+#define TRACE_VOLUNTEERS_PID 2 // One track per volunteer
+
+static std::atomic<uint64_t> nextTracerId(1);
+
+static long long steadyNanos()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+}
+
+Tracer::Ring::Ring(int threadId) : threadId(threadId), written(0), events(TRACE_RING_EVENTS) {}
+
+Tracer::Tracer() : id(nextTracerId++), started(steadyNanos()), ringsMutex(), rings() {}
+
+long long Tracer::now() const
+{
+    return steadyNanos() - started;
+}
+
+Tracer::Ring &Tracer::ring()
+{
+    thread_local uint64_t cachedTracer = 0;
+    thread_local Ring *cachedRing = nullptr;
+    if (cachedTracer != id)
+    {
+        std::lock_guard<std::mutex> lock(ringsMutex);
+        rings.emplace_back(new Ring(static_cast<int>(rings.size()) + 1));
+        cachedTracer = id;
+        cachedRing = rings.back().get();
+    }
+    return *cachedRing;
+}
+
+void Tracer::record(const TraceEvent &event)
+{
+    // Only this thread writes the ring, readers see the event once written is stored
+    Ring &target = ring();
+    uint64_t written = target.written.load(std::memory_order_relaxed);
+    target.events[written % TRACE_RING_EVENTS] = event;
+    target.written.store(written + 1, std::memory_order_release);
+}
+
+void Tracer::tick(int tick, long long begin, long long end)
+{
+    record(TraceEvent{TraceEventType::TICK, 0, tick, NO_ORDER, NO_VOLUNTEER, begin, end});
+}
+
+void Tracer::phase(ProfilePhase phase, int tick, long long begin, long long end)
+{
+    record(TraceEvent{TraceEventType::PHASE, static_cast<uint8_t>(phase), tick, NO_ORDER, NO_VOLUNTEER, begin, end});
+}
+
+void Tracer::order(const Order &order, int volunteerId, int tick)
+{
+    long long at = now();
+    record(TraceEvent{TraceEventType::ORDER, static_cast<uint8_t>(order.getStatus()), tick, order.getId(), volunteerId, at, at});
+}
+
+// Chrome trace timestamps are microseconds, keep the nanoseconds as decimals
+static void appendMicros(string &buffer, long long nanos)
+{
+    appendInt(buffer, nanos / 1000);
+    buffer += '.';
+    long long fraction = nanos % 1000;
+    if (fraction < 100)
+        buffer += '0';
+    if (fraction < 10)
+        buffer += '0';
+    appendInt(buffer, fraction);
+}
+
+static void appendTrack(string &buffer, int pid, int tid, long long begin)
+{
+    appendText(buffer, "\"pid\":");
+    appendInt(buffer, pid);
+    appendText(buffer, ",\"tid\":");
+    appendInt(buffer, tid);
+    appendText(buffer, ",\"ts\":");
+    appendMicros(buffer, begin);
+}
+
+static void appendName(string &buffer, int pid, int tid, const char *kind, std::string_view name)
+{
+    appendText(buffer, "{\"name\":\"");
+    appendText(buffer, kind);
+    appendText(buffer, "\",\"ph\":\"M\",\"pid\":");
+    appendInt(buffer, pid);
+    appendText(buffer, ",\"tid\":");
+    appendInt(buffer, tid);
+    appendText(buffer, ",\"args\":{\"name\":\"");
+    appendText(buffer, name);
+    appendText(buffer, "\"}},\n");
+}
+
+static void appendEvent(string &buffer, int threadId, const TraceEvent &event)
+{
+    switch (event.type)
+    {
+    case TraceEventType::TICK:
+    case TraceEventType::PHASE:
+        appendText(buffer, "{\"name\":\"");
+        appendText(buffer, event.type == TraceEventType::TICK ? "tick" : Profiler::getPhaseString(static_cast<ProfilePhase>(event.detail)));
+        appendText(buffer, event.type == TraceEventType::TICK ? "\",\"cat\":\"tick\",\"ph\":\"X\"," : "\",\"cat\":\"phase\",\"ph\":\"X\",");
+        appendTrack(buffer, TRACE_WAREHOUSE_PID, threadId, event.begin);
+        appendText(buffer, ",\"dur\":");
+        appendMicros(buffer, event.end - event.begin);
+        appendText(buffer, ",\"args\":{\"tick\":");
+        appendInt(buffer, event.tick);
+        appendText(buffer, "}},\n");
+        break;
+    case TraceEventType::ORDER:
+    {
+        OrderStatus status = static_cast<OrderStatus>(event.detail);
+        bool onVolunteer = event.volunteerId != NO_VOLUNTEER;
+        int pid = onVolunteer ? TRACE_VOLUNTEERS_PID : TRACE_WAREHOUSE_PID;
+        int tid = onVolunteer ? event.volunteerId : threadId;
+
+        // A slice for the flow to bind to, then the flow step itself
+        appendText(buffer, "{\"name\":\"order ");
+        appendInt(buffer, event.orderId);
+        buffer += ' ';
+        appendText(buffer, Order::getStatusString(status));
+        appendText(buffer, "\",\"cat\":\"order\",\"ph\":\"X\",");
+        appendTrack(buffer, pid, tid, event.begin);
+        appendText(buffer, ",\"dur\":0,\"args\":{\"order\":");
+        appendInt(buffer, event.orderId);
+        appendText(buffer, ",\"volunteer\":");
+        appendInt(buffer, event.volunteerId);
+        appendText(buffer, ",\"tick\":");
+        appendInt(buffer, event.tick);
+        appendText(buffer, "}},\n");
+
+        appendText(buffer, "{\"name\":\"order\",\"cat\":\"order\",\"ph\":\"");
+        appendText(buffer, status == OrderStatus::PENDING ? "s" : status == OrderStatus::COMPLETED ? "f" : "t");
+        appendText(buffer, "\",\"bp\":\"e\",\"id\":");
+        appendInt(buffer, event.orderId);
+        buffer += ',';
+        appendTrack(buffer, pid, tid, event.begin);
+        appendText(buffer, "},\n");
+        break;
+    }
+    }
+}
+
+bool Tracer::dump(const string &path) const
+{
+    string buffer = "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n";
+    appendName(buffer, TRACE_WAREHOUSE_PID, 0, "process_name", "warehouse");
+    appendName(buffer, TRACE_VOLUNTEERS_PID, 0, "process_name", "volunteers");
+    std::set<int> volunteerIds;
+    {
+        std::lock_guard<std::mutex> lock(ringsMutex);
+        for (const std::unique_ptr<Ring> &ring : rings)
+        {
+            string threadName = "thread " + std::to_string(ring->threadId);
+            appendName(buffer, TRACE_WAREHOUSE_PID, ring->threadId, "thread_name", threadName);
+            uint64_t written = ring->written.load(std::memory_order_acquire);
+            uint64_t first = written > TRACE_RING_EVENTS ? written - TRACE_RING_EVENTS : 0;
+            for (uint64_t i = first; i < written; i++)
+            {
+                const TraceEvent &event = ring->events[i % TRACE_RING_EVENTS];
+                appendEvent(buffer, ring->threadId, event);
+                if (event.type == TraceEventType::ORDER && event.volunteerId != NO_VOLUNTEER)
+                    volunteerIds.insert(event.volunteerId);
+            }
+        }
+    }
+    for (int volunteerId : volunteerIds)
+    {
+        appendName(buffer, TRACE_VOLUNTEERS_PID, volunteerId, "thread_name", "volunteer " + std::to_string(volunteerId));
+    }
+    buffer.resize(buffer.size() - 2); // The last ",\n"
+    appendText(buffer, "\n]}\n");
+
+    int fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (fd < 0)
+    {
+        return false;
+    }
+    size_t written = 0;
+    while (written < buffer.size())
+    {
+        ssize_t result = ::write(fd, buffer.data() + written, buffer.size() - written);
+        if (result <= 0)
+        {
+            break;
+        }
+        written += result;
+    }
+    return ::close(fd) == 0 && written == buffer.size();
+}
@@ -1,8 +1,11 @@
 #include "../include/Volunteer.h"
 #include "../include/Order.h"
+#include "../include/Format.h"
+
+#include <algorithm>
 
 // Volunteer class implementation
-Volunteer::Volunteer(int id, const string &name) : completedOrderId(NO_ORDER), activeOrderId(NO_ORDER), id(id), name(name) {}
+Volunteer::Volunteer(int id, const string &name) : completedOrderId(NO_ORDER), activeOrderId(NO_ORDER), id(id), name(NameTable::intern(name)) {}
 
 int Volunteer::getId() const
 {
@@ -10,6 +13,11 @@ int Volunteer::getId() const
 }
 
 const string &Volunteer::getName() const
+{
+    return NameTable::lookup(name);
+}
+
+NameId Volunteer::getNameId() const
 {
     return name;
 }
@@ -29,9 +37,20 @@ bool Volunteer::isBusy() const
     return activeOrderId != NO_ORDER;
 }
 
+VolunteerTimers Volunteer::getTimers() const
+{
+    return VolunteerTimers{activeOrderId, completedOrderId, 0, NO_LIMIT};
+}
+
+void Volunteer::setTimers(const VolunteerTimers &timers)
+{
+    activeOrderId = timers.activeOrderId;
+    completedOrderId = timers.completedOrderId;
+}
+
 // CollectorVolunteer implementation
 
-CollectorVolunteer::CollectorVolunteer(int id, const string &name, int coolDown) : Volunteer(id, name), coolDown(coolDown), timeLeft(0) {}
+CollectorVolunteer::CollectorVolunteer(int id, const string &name, int coolDown, int waveSize) : Volunteer(id, name), coolDown(coolDown), timeLeft(0), waveSize(waveSize) {}
 
 CollectorVolunteer *CollectorVolunteer::clone() const
 {
@@ -47,6 +66,19 @@ void CollectorVolunteer::step()
     }
 }
 
+VolunteerTimers CollectorVolunteer::getTimers() const
+{
+    VolunteerTimers timers = Volunteer::getTimers();
+    timers.timeLeft = timeLeft;
+    return timers;
+}
+
+void CollectorVolunteer::setTimers(const VolunteerTimers &timers)
+{
+    Volunteer::setTimers(timers);
+    timeLeft = timers.timeLeft;
+}
+
 int CollectorVolunteer::getCoolDown() const
 {
     return coolDown;
@@ -86,9 +118,24 @@ void CollectorVolunteer::acceptOrder(const Order &order)
     }
 }
 
+int CollectorVolunteer::getWaveSize() const
+{
+    return waveSize;
+}
+
+int CollectorVolunteer::getWaveRoom() const
+{
+    return waveSize - 1;
+}
+
+void CollectorVolunteer::joinWave(const Order &)
+{
+    // The order names this collector; it is done when the first order of the wave is
+}
+
 // LimitedCollectorVolunteer class implementation
 
-LimitedCollectorVolunteer::LimitedCollectorVolunteer(int id, const string &name, int coolDown, int maxOrders) : CollectorVolunteer(id, name, coolDown), maxOrders(maxOrders), ordersLeft(maxOrders) {}
+LimitedCollectorVolunteer::LimitedCollectorVolunteer(int id, const string &name, int coolDown, int maxOrders, int waveSize) : CollectorVolunteer(id, name, coolDown, waveSize), maxOrders(maxOrders), ordersLeft(maxOrders) {}
 
 LimitedCollectorVolunteer *LimitedCollectorVolunteer::clone() const
 {
@@ -114,6 +161,30 @@ void LimitedCollectorVolunteer::acceptOrder(const Order &order)
     }
 }
 
+int LimitedCollectorVolunteer::getWaveRoom() const
+{
+    return std::min(CollectorVolunteer::getWaveRoom(), ordersLeft);
+}
+
+void LimitedCollectorVolunteer::joinWave(const Order &order)
+{
+    CollectorVolunteer::joinWave(order);
+    ordersLeft--;
+}
+
+VolunteerTimers LimitedCollectorVolunteer::getTimers() const
+{
+    VolunteerTimers timers = CollectorVolunteer::getTimers();
+    timers.ordersLeft = ordersLeft;
+    return timers;
+}
+
+void LimitedCollectorVolunteer::setTimers(const VolunteerTimers &timers)
+{
+    CollectorVolunteer::setTimers(timers);
+    ordersLeft = timers.ordersLeft;
+}
+
 int LimitedCollectorVolunteer::getMaxOrders() const
 {
     return maxOrders;
@@ -134,6 +205,19 @@ DriverVolunteer *DriverVolunteer::clone() const
     return new DriverVolunteer(*this);
 }
 
+VolunteerTimers DriverVolunteer::getTimers() const
+{
+    VolunteerTimers timers = Volunteer::getTimers();
+    timers.timeLeft = distanceLeft;
+    return timers;
+}
+
+void DriverVolunteer::setTimers(const VolunteerTimers &timers)
+{
+    Volunteer::setTimers(timers);
+    distanceLeft = timers.timeLeft;
+}
+
 int DriverVolunteer::getDistanceLeft() const
 {
     return distanceLeft;
@@ -194,6 +278,19 @@ LimitedDriverVolunteer *LimitedDriverVolunteer::clone() const
     return new LimitedDriverVolunteer(*this);
 }
 
+VolunteerTimers LimitedDriverVolunteer::getTimers() const
+{
+    VolunteerTimers timers = DriverVolunteer::getTimers();
+    timers.ordersLeft = ordersLeft;
+    return timers;
+}
+
+void LimitedDriverVolunteer::setTimers(const VolunteerTimers &timers)
+{
+    DriverVolunteer::setTimers(timers);
+    ordersLeft = timers.ordersLeft;
+}
+
 int LimitedDriverVolunteer::getMaxOrders() const
 {
     return maxOrders;
@@ -223,37 +320,59 @@ void LimitedDriverVolunteer::acceptOrder(const Order &order)
     }
 }
 
-std::string Volunteer::toString() const
+string Volunteer::toString() const
+{
+    string buffer;
+    appendTo(buffer);
+    return buffer;
+}
+
+void Volunteer::appendTo(string &buffer) const
 {
-    std::stringstream ss;
-    ss << "Volunteer ID: " << getId() << ", Name: " << getName();
-    return ss.str();
+    appendText(buffer, "Volunteer ID: ");
+    appendInt(buffer, getId());
+    appendText(buffer, ", Name: ");
+    appendText(buffer, getName());
 }
 
-std::string CollectorVolunteer::toString() const
+void CollectorVolunteer::appendTo(string &buffer) const
 {
-    std::stringstream ss;
-    ss << "Collector Volunteer - " << Volunteer::toString() << ", Cool Down: " << getCoolDown() << ", Time Left: " << getTimeLeft();
-    return ss.str();
+    appendText(buffer, "Collector Volunteer - ");
+    Volunteer::appendTo(buffer);
+    appendText(buffer, ", Cool Down: ");
+    appendInt(buffer, getCoolDown());
+    appendText(buffer, ", Time Left: ");
+    appendInt(buffer, getTimeLeft());
 }
 
-std::string LimitedCollectorVolunteer::toString() const
+void LimitedCollectorVolunteer::appendTo(string &buffer) const
 {
-    std::stringstream ss;
-    ss << "Limited Collector Volunteer - " << CollectorVolunteer::toString() << ", Max Orders: " << getMaxOrders() << ", Orders Left: " << getNumOrdersLeft();
-    return ss.str();
+    appendText(buffer, "Limited Collector Volunteer - ");
+    CollectorVolunteer::appendTo(buffer);
+    appendText(buffer, ", Max Orders: ");
+    appendInt(buffer, getMaxOrders());
+    appendText(buffer, ", Orders Left: ");
+    appendInt(buffer, getNumOrdersLeft());
 }
 
-std::string DriverVolunteer::toString() const
+void DriverVolunteer::appendTo(string &buffer) const
 {
-    std::stringstream ss;
-    ss << "Driver Volunteer - " << Volunteer::toString() << ", Max Distance: " << getMaxDistance() << ", Distance Per Step: " << getDistancePerStep() << ", Distance Left: " << getDistanceLeft();
-    return ss.str();
+    appendText(buffer, "Driver Volunteer - ");
+    Volunteer::appendTo(buffer);
+    appendText(buffer, ", Max Distance: ");
+    appendInt(buffer, getMaxDistance());
+    appendText(buffer, ", Distance Per Step: ");
+    appendInt(buffer, getDistancePerStep());
+    appendText(buffer, ", Distance Left: ");
+    appendInt(buffer, getDistanceLeft());
 }
 
-std::string LimitedDriverVolunteer::toString() const
+void LimitedDriverVolunteer::appendTo(string &buffer) const
 {
-    std::stringstream ss;
-    ss << "Limited Driver Volunteer - " << DriverVolunteer::toString() << ", Max Orders: " << getMaxOrders() << ", Orders Left: " << getNumOrdersLeft();
-    return ss.str();
-}
\ No newline at end of file
+    appendText(buffer, "Limited Driver Volunteer - ");
+    DriverVolunteer::appendTo(buffer);
+    appendText(buffer, ", Max Orders: ");
+    appendInt(buffer, getMaxOrders());
+    appendText(buffer, ", Orders Left: ");
+    appendInt(buffer, getNumOrdersLeft());
+}
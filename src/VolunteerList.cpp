@@ -0,0 +1,91 @@
+#include "../include/VolunteerList.h"
+
+VolunteerList::VolunteerList() : slots(), staleIds() {}
+
+VolunteerList::VolunteerList(const VolunteerList &other) : slots(other.slots), staleIds() {}
+
+VolunteerList &VolunteerList::operator=(const VolunteerList &other)
+{
+    if (this != &other)
+    {
+        slots = other.slots;
+        staleIds.clear();
+    }
+    return *this;
+}
+
+// The slot of the volunteer's concrete type holding a copy of it
+static VolunteerSlot makeSlot(const Volunteer &volunteer)
+{
+    // The limited types first, they derive from the unlimited ones
+    if (const LimitedCollectorVolunteer *limitedCollector = dynamic_cast<const LimitedCollectorVolunteer *>(&volunteer))
+        return *limitedCollector;
+    if (const CollectorVolunteer *collector = dynamic_cast<const CollectorVolunteer *>(&volunteer))
+        return *collector;
+    if (const LimitedDriverVolunteer *limitedDriver = dynamic_cast<const LimitedDriverVolunteer *>(&volunteer))
+        return *limitedDriver;
+    return dynamic_cast<const DriverVolunteer &>(volunteer);
+}
+
+void VolunteerList::add(const Volunteer &volunteer)
+{
+    slots.push_back(makeSlot(volunteer));
+}
+
+void VolunteerList::replace(size_t index, const Volunteer &volunteer)
+{
+    slots[index] = makeSlot(volunteer);
+}
+
+void VolunteerList::erase(size_t index)
+{
+    // The last slot falls past the end still holding the last volunteer
+    size_t last = slots.size() - 1;
+    if (staleIds.size() <= last)
+    {
+        staleIds.resize(last + 1, NO_VOLUNTEER);
+    }
+    staleIds[last] = (*this)[last]->getId();
+    slots.erase(slots.begin() + index);
+}
+
+void VolunteerList::clear()
+{
+    // Every volunteer is gone, so no slot past the end refers to one
+    slots.clear();
+    staleIds.clear();
+}
+
+size_t VolunteerList::size() const
+{
+    return slots.size();
+}
+
+int VolunteerList::staleId(size_t index) const
+{
+    if (index < slots.size() || index >= staleIds.size())
+    {
+        return NO_VOLUNTEER;
+    }
+    return staleIds[index];
+}
+
+Volunteer *VolunteerList::operator[](size_t index)
+{
+    return std::visit([](Volunteer &volunteer) { return &volunteer; }, slots[index]);
+}
+
+const Volunteer *VolunteerList::operator[](size_t index) const
+{
+    return std::visit([](const Volunteer &volunteer) { return &volunteer; }, slots[index]);
+}
+
+vector<VolunteerSlot> &VolunteerList::getSlots()
+{
+    return slots;
+}
+
+const vector<VolunteerSlot> &VolunteerList::getSlots() const
+{
+    return slots;
+}
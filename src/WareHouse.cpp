@@ -3,12 +3,21 @@
 #include "../include/Order.h"
 #include "../include/Volunteer.h"
 #include "../include/Action.h"
+#include "../include/OutputSink.h"
+#include "../include/SimulationClock.h"
+#include "../include/Profiler.h"
+#include "../include/Tracer.h"
+#include "../include/Format.h"
+#include "../include/Scenario.h"
+#include "../include/Planner.h"
 
 #include <fstream>
+#include <type_traits>
+#include <typeinfo>
 #include <iostream>
 #include <sstream>
 
-WareHouse::WareHouse(const string &configFilePath) : isOpen(false), actionsLog(), volunteers(), pendingOrders(), inProcessOrders(), completedOrders(), customers(), customerCounter(0), volunteerCounter(0), orderCounter(0)
+WareHouse::WareHouse(const string &configFilePath) : isOpen(false), actionsLog(), volunteers(), orders(), pendingOrders(), inProcessOrders(), pendingFrom(0), collectedFrom(0), completedOrders(), customers(), customerCounter(0), volunteerCounter(0), orderCounter(0), currentTick(0), summary(), intake(), intakeBatch(), stepsDrainIntake(true), publisher(nullptr), clock(nullptr), profiler(nullptr), tracer(nullptr), checkpoints(), backgroundSave(), throughput(), demand(), restoreCount(0)
 {
     // Read configuration file & set up
     readConfigAndSetup(configFilePath);
@@ -18,120 +27,346 @@ void WareHouse::start()
 {
     open();
     std::cout << "Warehouse is open!" << std::endl;
+    if (clock != nullptr)
+    {
+        clock->start();
+    }
 
     std::string userInput;
     while (isOpen)
     {
-        // Wait for user input
-        std::cout << "Enter an action: ";
+        // Command boundary: apply requests from producer threads and hand the
+        // buffered report of the last command to the OS
+        {
+            std::unique_lock<std::mutex> tickBoundary = holdClock();
+            drainIntake();
+        }
+        output.flush();
+
+        // Wait for user input, the clock keeps ticking meanwhile
+        std::cout << "Enter an action: " << std::flush;
         std::getline(std::cin, userInput);
+        std::unique_lock<std::mutex> tickBoundary = holdClock();
 
-        if (userInput == "log")
+        if (!execute(userInput))
         {
-            // Execute PrintActionsLog action
-            PrintActionsLog action;
-            action.act(*this);
+            return;
         }
-        else if (userInput == "close")
+    }
+    output.flush();
+}
+
+// Parse one command line and run its action, returns false if an ID could not be parsed
+bool WareHouse::execute(const string &userInput)
+{
+    if (profiler == nullptr)
+    {
+        return executeCommand(userInput);
+    }
+    // Counted under the command's first word
+    ProfileSample begin = profiler->sample();
+    bool parsed = executeCommand(userInput);
+    profiler->addCommand(userInput.substr(0, userInput.find(' ')), begin);
+    return parsed;
+}
+
+bool WareHouse::executeCommand(const string &userInput)
+{
+    if (userInput == "log")
+    {
+        // Execute PrintActionsLog action
+        PrintActionsLog action;
+        action.act(*this);
+    }
+    else if (userInput == "clock")
+    {
+        // Report the background clock; like report, this is not an action
+        string report;
+        if (clock == nullptr)
         {
-            // Execute Close action
-            Close action;
-            action.act(*this);
+            report = "Clock is not running\n";
         }
-        else if (userInput == "backup")
+        else
         {
-            // Execute BackupWarehouse action
-            BackupWareHouse action;
-            action.act(*this);
+            clock->appendReport(report);
         }
-        else if (userInput == "restore")
+        output << report;
+    }
+    else if (userInput.substr(0, 7) == "profile")
+    {
+        // Hardware counters per phase and command, "profile reset" or "profile <csv_path>"; not an action
+        string argument = userInput.size() > 8 ? userInput.substr(8) : "";
+        string report;
+        if (profiler == nullptr)
         {
-            // Execute RestoreWarehouse action
-            RestoreWareHouse action;
-            action.act(*this);
+            report = "Profiling is off\n";
         }
-        else if (userInput.substr(0, 4) == "step")
+        else if (argument.empty())
         {
-            // Extract order ID from input
-            int numOfSteps;
-            if (sscanf(userInput.substr(5).c_str(), "%d", &numOfSteps) != 1)
-            {
-                std::cerr << "Invalid order ID!" << std::endl;
-                return; 
-            }
-
-            SimulateStep action(numOfSteps);
-            action.act(*this);
+            profiler->appendReport(report);
         }
-        else if (userInput.substr(0, 11) == "orderStatus")
+        else if (argument == "reset")
         {
-            // Extract order ID from input
-            int orderId;
-            if (sscanf(userInput.substr(12).c_str(), "%d", &orderId) != 1)
-            {
-                std::cerr << "Invalid order ID!" << std::endl;
-                return;
-            }
-
-            // Execute PrintOrderStatus action
-            PrintOrderStatus action(orderId);
-            action.act(*this);
+            profiler->reset();
         }
-        else if (userInput.substr(0, 14) == "customerStatus")
+        else if (!profiler->dump(argument))
         {
-            // Extract customer ID from input
-            int customerId;
-            if (sscanf(userInput.substr(15).c_str(), "%d", &customerId) != 1)
-            {
-                std::cerr << "Invalid customer ID!" << std::endl;
-                return;
-            }
-
-            // Execute PrintCustomerStatus action
-            PrintCustomerStatus action(customerId);
-            action.act(*this);
+            report = "Cannot write profile: " + argument + "\n";
+        }
+        output << report;
+    }
+    else if (userInput.substr(0, 6) == "report")
+    {
+        // Redirect report output to a file, or back to stdout; not an action
+        string path = userInput.size() > 7 ? userInput.substr(7) : "stdout";
+        if (path == "stdout")
+        {
+            output.restore();
+        }
+        else if (!output.redirect(path))
+        {
+            output << "Cannot open report file: " << path << '\n';
         }
-        else if (userInput.substr(0, 15) == "volunteerStatus")
+    }
+    else if (userInput == "summary")
+    {
+        // Order, volunteer and customer counts, kept up to date as they change; not an action
+        string report;
+        appendSummary(report);
+        output << report;
+    }
+    else if (userInput.substr(0, 9) == "scenario ")
+    {
+        // "scenario <horizon> <mutation>, ...; ..." runs copies of the warehouse side by side; not an action
+        std::istringstream arguments(userInput.substr(9));
+        int horizon = 0;
+        string scenarios;
+        arguments >> horizon;
+        std::getline(arguments, scenarios);
+        string report;
+        try
+        {
+            ScenarioRunner runner(*this, horizon);
+            runner.run(ScenarioRunner::parse(scenarios));
+            runner.appendTable(report);
+        }
+        catch (const std::invalid_argument &exception)
+        {
+            report = string("Invalid scenario: ") + exception.what() + "\n";
+        }
+        output << report;
+    }
+    else if (userInput.substr(0, 6) == "demand")
+    {
+        // "demand", "demand off", "demand seed <seed>" or "demand <process>" drive the order generator; not an action
+        string argument = userInput.size() > 7 ? userInput.substr(7) : "";
+        string report;
+        try
         {
-            // Extract volunteer ID from input
-            int volunteerId;
-            if (sscanf(userInput.substr(16).c_str(), "%d", &volunteerId) != 1)
+            if (argument.empty())
             {
-                std::cerr << "Invalid volunteer ID!" << std::endl;
-                return;
+                demand.appendReport(report);
+            }
+            else if (argument == "off")
+            {
+                demand.clear();
+            }
+            else if (argument.substr(0, 5) == "seed ")
+            {
+                string seedText = argument.substr(5);
+                size_t used = 0;
+                uint64_t seed = 0;
+                try
+                {
+                    seed = std::stoull(seedText, &used);
+                }
+                catch (const std::exception &)
+                {
+                    used = 0;
+                }
+                if (used == 0 || used != seedText.size() || seedText[0] == '-')
+                    throw std::invalid_argument("Not a seed: " + seedText);
+                demand.setSeed(seed);
+            }
+            else
+            {
+                demand.add(argument);
             }
-
-            // Execute PrintVolunteerStatus action
-            PrintVolunteerStatus action(volunteerId);
-            action.act(*this);
         }
-        else if (userInput.substr(0, 5) == "order")
+        catch (const std::invalid_argument &exception)
         {
-            // Extract the customer ID from the input
-            std::string customerIDString = userInput.substr(6);
-            int customerID = std::stoi(customerIDString);
-
-            // Execute AddOrder action
-            AddOrder action(customerID);
-            action.act(*this);
+            report = string("Invalid demand: ") + exception.what() + "\n";
         }
-        else if (userInput.substr(0, 8) == "customer")
+        output << report;
+    }
+    else if (userInput.substr(0, 5) == "plan ")
+    {
+        // "plan <horizon> [collector ...] [driver ...]" sizes the volunteers on copies of the warehouse; not an action
+        std::istringstream arguments(userInput.substr(5));
+        int horizon = 0;
+        string volunteerText;
+        arguments >> horizon;
+        std::getline(arguments, volunteerText);
+        string report;
+        try
         {
-            // Extract customer details from input
-            std::istringstream iss(userInput.substr(9));
-            std::string name, typeString;
-            int distance, maxOrders;
-            iss >> name >> typeString >> distance >> maxOrders;
+            CapacityPlanner planner(*this, horizon);
+            planner.setVolunteers(volunteerText);
+            planner.plan();
+            planner.appendReport(report);
+        }
+        catch (const std::invalid_argument &exception)
+        {
+            report = string("Invalid plan: ") + exception.what() + "\n";
+        }
+        output << report;
+    }
+    else if (userInput == "throughput")
+    {
+        // Order rates and utilization over the last ticks; not an action
+        string report;
+        throughput.appendReport(report);
+        output << report;
+    }
+    else if (userInput.substr(0, 6) == "trace ")
+    {
+        // Write the trace so far as Chrome trace JSON; not an action
+        string path = userInput.substr(6);
+        if (tracer == nullptr)
+            output << "Tracing is off\n";
+        else if (!tracer->dump(path))
+            output << "Cannot write trace: " + path + "\n";
+    }
+    else if (userInput == "close")
+    {
+        // Execute Close action
+        Close action;
+        action.act(*this);
+    }
+    else if (userInput == "backup")
+    {
+        // Execute BackupWarehouse action
+        BackupWareHouse action;
+        action.act(*this);
+    }
+    else if (userInput == "restore")
+    {
+        // Execute RestoreWarehouse action
+        RestoreWareHouse action;
+        action.act(*this);
+    }
+    else if (userInput.substr(0, 7) == "backup ")
+    {
+        // Save a named checkpoint
+        SaveCheckpoint action(userInput.substr(7));
+        action.act(*this);
+    }
+    else if (userInput.substr(0, 8) == "restore ")
+    {
+        // Go back to a named checkpoint
+        RestoreCheckpoint action(userInput.substr(8));
+        action.act(*this);
+    }
+    else if (userInput == "checkpoints")
+    {
+        // List the named checkpoints
+        PrintCheckpoints action;
+        action.act(*this);
+    }
+    else if (userInput.substr(0, 5) == "save ")
+    {
+        // Write a snapshot file from a forked child, commands go on meanwhile
+        SaveSnapshot action(userInput.substr(5));
+        action.act(*this);
+    }
+    else if (userInput == "saveStatus")
+    {
+        // Progress of the last background save
+        PrintSaveStatus action;
+        action.act(*this);
+    }
+    else if (userInput.substr(0, 4) == "step")
+    {
+        // Extract order ID from input
+        int numOfSteps;
+        if (sscanf(userInput.substr(5).c_str(), "%d", &numOfSteps) != 1)
+        {
+            std::cerr << "Invalid order ID!" << std::endl;
+            return false;
+        }
 
-            // Execute AddCustomer action
-            AddCustomer action(name, typeString, distance, maxOrders);
-            action.act(*this);
+        SimulateStep action(numOfSteps);
+        action.act(*this);
+    }
+    else if (userInput.substr(0, 11) == "orderStatus")
+    {
+        // Extract order ID from input
+        int orderId;
+        if (sscanf(userInput.substr(12).c_str(), "%d", &orderId) != 1)
+        {
+            std::cerr << "Invalid order ID!" << std::endl;
+            return false;
         }
-        else
+
+        // Execute PrintOrderStatus action
+        PrintOrderStatus action(orderId);
+        action.act(*this);
+    }
+    else if (userInput.substr(0, 14) == "customerStatus")
+    {
+        // Extract customer ID from input
+        int customerId;
+        if (sscanf(userInput.substr(15).c_str(), "%d", &customerId) != 1)
         {
-            std::cout << "Invalid action!" << std::endl;
+            std::cerr << "Invalid customer ID!" << std::endl;
+            return false;
         }
+
+        // Execute PrintCustomerStatus action
+        PrintCustomerStatus action(customerId);
+        action.act(*this);
+    }
+    else if (userInput.substr(0, 15) == "volunteerStatus")
+    {
+        // Extract volunteer ID from input
+        int volunteerId;
+        if (sscanf(userInput.substr(16).c_str(), "%d", &volunteerId) != 1)
+        {
+            std::cerr << "Invalid volunteer ID!" << std::endl;
+            return false;
+        }
+
+        // Execute PrintVolunteerStatus action
+        PrintVolunteerStatus action(volunteerId);
+        action.act(*this);
+    }
+    else if (userInput.substr(0, 5) == "order")
+    {
+        // Extract the customer ID from the input
+        std::string customerIDString = userInput.substr(6);
+        int customerID = std::stoi(customerIDString);
+
+        // Execute AddOrder action
+        AddOrder action(customerID);
+        action.act(*this);
+    }
+    else if (userInput.substr(0, 8) == "customer")
+    {
+        // Extract customer details from input
+        std::istringstream iss(userInput.substr(9));
+        std::string name, typeString;
+        int distance, maxOrders;
+        iss >> name >> typeString >> distance >> maxOrders;
+
+        // Execute AddCustomer action
+        AddCustomer action(name, typeString, distance, maxOrders);
+        action.act(*this);
+    }
+    else
+    {
+        output << "Invalid action!\n";
     }
+    return true;
 }
 
 int WareHouse::getCustomerCounter() const
@@ -144,6 +379,11 @@ int WareHouse::getOrderCounter() const
     return orderCounter;
 }
 
+int WareHouse::getCurrentTick() const
+{
+    return currentTick;
+}
+
 int WareHouse::getVolunteerCounter() const
 {
     return volunteerCounter;
@@ -154,14 +394,42 @@ void WareHouse::setOrderCounter()
     orderCounter++;
 }
 
-void WareHouse::addOrder(Order *order)
+bool WareHouse::placeOrder(Customer &customer)
 {
-    pendingOrders.push_back(order);
+    if (customer.addOrder(orderCounter) < 0)
+    {
+        return false;
+    }
+    addOrder(Order(orderCounter, customer.getId(), customer.getCustomerDistance()));
+    setOrderCounter();
+    return true;
 }
 
-void WareHouse::addAction(BaseAction *action)
+void WareHouse::addOrder(const Order &order)
 {
-    actionsLog.push_back(action);
+    pendingFrom = std::min(pendingFrom, pendingOrders.size());
+    pendingOrders.push_back(&orders.add(order));
+    summary.pendingOrders++;
+    throughput.orderCreated();
+    // Customers are indexed by their id; AddOrder has already counted this order for its customer
+    if (!customers[order.getCustomerId()]->canMakeOrder())
+    {
+        summary.customersAtLimit++;
+    }
+    if (tracer != nullptr)
+    {
+        tracer->order(order, NO_VOLUNTEER, currentTick);
+    }
+}
+
+void WareHouse::addAction(const BaseAction &action)
+{
+    actionsLog.append(action.toRecord(), action.getRecordText());
+}
+
+void WareHouse::amendLastAction(const BaseAction &action)
+{
+    actionsLog.replaceLast(action.toRecord());
 }
 
 Customer &WareHouse::getCustomer(int customerId) const
@@ -178,7 +446,8 @@ Customer &WareHouse::getCustomer(int customerId) const
 
 Volunteer &WareHouse::getVolunteer(int volunteerId) const
 {
-    for (const auto &volunteer : volunteers)
+    // Volunteers are held by value now, but callers still get a mutable one as before
+    for (Volunteer *volunteer : const_cast<VolunteerList &>(volunteers))
     {
         if (volunteer->getId() == volunteerId)
         {
@@ -190,31 +459,31 @@ Volunteer &WareHouse::getVolunteer(int volunteerId) const
 
 Order &WareHouse::getOrder(int orderId) const
 {
-    for (const auto &order : pendingOrders)
+    const Order *order = orders.find(orderId);
+    if (order != nullptr)
     {
-        if (order->getId() == orderId)
-        {
-            return *order;
-        }
+        return const_cast<Order &>(*order);
     }
-    for (const auto &order : inProcessOrders)
+    throw std::runtime_error("Order not found with ID: " + std::to_string(orderId));
+}
+
+OrderStatus WareHouse::getOrderStatus(int orderId) const
+{
+    // Live orders first: the table is one lookup, the archive grows with history
+    const Order *order = orders.find(orderId);
+    if (order != nullptr)
     {
-        if (order->getId() == orderId)
-        {
-            return *order;
-        }
+        return order->getStatus();
     }
-    for (const auto &order : completedOrders)
+    ArchivedOrder archived;
+    if (completedOrders.find(orderId, archived))
     {
-        if (order->getId() == orderId)
-        {
-            return *order;
-        }
+        return OrderStatus::COMPLETED;
     }
     throw std::runtime_error("Order not found with ID: " + std::to_string(orderId));
 }
 
-const vector<BaseAction *> &WareHouse::getActions() const
+const ActionLog &WareHouse::getActions() const
 {
     return actionsLog;
 }
@@ -229,7 +498,12 @@ const vector<Order *> &WareHouse::getInProcessOrders() const
     return inProcessOrders;
 }
 
-const vector<Order *> &WareHouse::getCompletedOrders() const
+const OrderTable &WareHouse::getLiveOrders() const
+{
+    return orders;
+}
+
+const OrderArchive &WareHouse::getCompletedOrders() const
 {
     return completedOrders;
 }
@@ -239,43 +513,147 @@ const vector<Customer *> &WareHouse::getCustomers() const
     return customers;
 }
 
-WareHouse::~WareHouse()
+const VolunteerList &WareHouse::getVolunteers() const
+{
+    return volunteers;
+}
+
+int WareHouse::getRestoreCount() const
+{
+    return restoreCount;
+}
+
+void WareHouse::setStepsDrainIntake(bool drain)
 {
-    // Free memory for actionsLog
-    for (BaseAction *action : actionsLog)
+    stepsDrainIntake = drain;
+}
+
+void WareHouse::setPublisher(SnapshotPublisher *newPublisher)
+{
+    publisher = newPublisher;
+}
+
+CheckpointStore &WareHouse::getCheckpoints()
+{
+    return checkpoints;
+}
+
+BackgroundSave &WareHouse::getBackgroundSave()
+{
+    return backgroundSave;
+}
+
+void WareHouse::clearState()
+{
+    actionsLog.clear();
+    volunteers.clear();
+    for (Customer *customer : customers)
     {
-        delete action;
+        delete customer;
     }
-    actionsLog.clear();
+    customers.clear();
+    pendingOrders.clear();
+    inProcessOrders.clear();
+    pendingFrom = 0;
+    collectedFrom = 0;
+    orders = OrderTable();
+    completedOrders = OrderArchive();
+    customerCounter = 0;
+    volunteerCounter = 0;
+    orderCounter = 0;
+    currentTick = 0;
+    summary = WareHouseSummary();
+    restoreCount++;
+}
 
-    // Free memory for volunteers
-    for (Volunteer *volunteer : volunteers)
+void WareHouse::recountSummary()
+{
+    summary = WareHouseSummary();
+    for (const vector<Order *> *queue : {&pendingOrders, &inProcessOrders})
     {
-        delete volunteer;
+        for (const Order *order : *queue)
+        {
+            if (order->getStatus() == OrderStatus::PENDING)
+                summary.pendingOrders++;
+            else if (order->getStatus() == OrderStatus::COLLECTING)
+                summary.collectingOrders++;
+            else if (order->getStatus() == OrderStatus::DELIVERING)
+                summary.deliveringOrders++;
+        }
     }
-    volunteers.clear();
-
-    // Free memory for pendingOrders
-    for (Order *order : pendingOrders)
+    summary.completedOrders = completedOrders.size();
+    for (const Volunteer *volunteer : volunteers)
     {
-        delete order;
+        summary.busyVolunteers += volunteer->isBusy();
     }
-    pendingOrders.clear();
-
-    // Free memory for inProcessOrders
-    for (Order *order : inProcessOrders)
+    for (const Customer *customer : customers)
     {
-        delete order;
+        summary.customersAtLimit += !customer->canMakeOrder();
     }
-    inProcessOrders.clear();
+}
+
+const WareHouseSummary &WareHouse::getSummary() const
+{
+    return summary;
+}
+
+const ThroughputMeter &WareHouse::getThroughput() const
+{
+    return throughput;
+}
+
+void WareHouse::appendSummary(string &buffer) const
+{
+    int volunteerCount = static_cast<int>(volunteers.size());
+    appendText(buffer, "Tick: ");
+    appendInt(buffer, currentTick);
+    appendText(buffer, "\nOrders: pending ");
+    appendInt(buffer, summary.pendingOrders);
+    appendText(buffer, ", collecting ");
+    appendInt(buffer, summary.collectingOrders);
+    appendText(buffer, ", delivering ");
+    appendInt(buffer, summary.deliveringOrders);
+    appendText(buffer, ", completed ");
+    appendInt(buffer, summary.completedOrders);
+    appendText(buffer, "\nVolunteers: ");
+    appendInt(buffer, volunteerCount);
+    appendText(buffer, ", busy ");
+    appendInt(buffer, summary.busyVolunteers);
+    appendText(buffer, ", idle ");
+    appendInt(buffer, volunteerCount - summary.busyVolunteers);
+    appendText(buffer, "\nCustomers: ");
+    appendInt(buffer, customers.size());
+    appendText(buffer, ", at order limit ");
+    appendInt(buffer, summary.customersAtLimit);
+    buffer += '\n';
+}
 
-    // Free memory for completedOrders
-    for (Order *order : completedOrders)
+void WareHouse::setClock(SimulationClock *newClock)
+{
+    clock = newClock;
+}
+
+void WareHouse::setProfiler(Profiler *newProfiler)
+{
+    profiler = newProfiler;
+}
+
+void WareHouse::setTracer(Tracer *newTracer)
+{
+    tracer = newTracer;
+}
+
+std::unique_lock<std::mutex> WareHouse::holdClock()
+{
+    if (clock == nullptr)
     {
-        delete order;
+        return std::unique_lock<std::mutex>();
     }
-    completedOrders.clear();
+    return clock->holdTick();
+}
 
+WareHouse::~WareHouse()
+{
     // Free memory for customers
     for (Customer *customer : customers)
     {
@@ -285,52 +663,35 @@ WareHouse::~WareHouse()
 }
 
 WareHouse::WareHouse(const WareHouse &other) : isOpen(other.isOpen),
-                                               actionsLog(),
-                                               volunteers(),
+                                               actionsLog(other.actionsLog),
+                                               volunteers(other.volunteers),
+                                               orders(other.orders),
                                                pendingOrders(),
                                                inProcessOrders(),
-                                               completedOrders(),
+                                               pendingFrom(other.pendingFrom),
+                                               collectedFrom(other.collectedFrom),
+                                               completedOrders(other.completedOrders),
                                                customers(),
                                                customerCounter(other.customerCounter),
                                                volunteerCounter(other.volunteerCounter),
-                                               orderCounter(other.orderCounter)
+                                               orderCounter(other.orderCounter),
+                                               currentTick(other.currentTick),
+                                               summary(other.summary),
+                                               intake(),
+                                               intakeBatch(),
+                                               stepsDrainIntake(true),
+                                               publisher(nullptr),
+                                               clock(nullptr),
+                                               profiler(nullptr),
+                                               tracer(nullptr),
+                                               checkpoints(),
+                                               backgroundSave(),
+                                               throughput(),
+                                               demand(),
+                                               restoreCount(other.restoreCount)
 {
-    // Deep copy actionsLog
-    for (const auto &action : other.actionsLog)
-    {
-        actionsLog.push_back(action->clone());
-    }
-
-    // Deep copy volunteers
-    for (const auto &volunteer : other.volunteers)
-    {
-        if (dynamic_cast<LimitedCollectorVolunteer *>(volunteer))
-            volunteers.push_back(new LimitedCollectorVolunteer(std::move(*dynamic_cast<LimitedCollectorVolunteer *>(volunteer))));
-        else if (dynamic_cast<CollectorVolunteer *>(volunteer))
-            volunteers.push_back(new CollectorVolunteer(std::move(*dynamic_cast<CollectorVolunteer *>(volunteer))));
-        if (dynamic_cast<LimitedDriverVolunteer *>(volunteer))
-            volunteers.push_back(new LimitedDriverVolunteer(std::move(*dynamic_cast<LimitedDriverVolunteer *>(volunteer))));
-        else if (dynamic_cast<DriverVolunteer *>(volunteer))
-            volunteers.push_back(new DriverVolunteer(std::move(*dynamic_cast<DriverVolunteer *>(volunteer))));
-    }
-
-    // Deep copy pendingOrders
-    for (const auto &order : other.pendingOrders)
-    {
-        pendingOrders.push_back(new Order(*order));
-    }
-
-    // Deep copy inProcessOrders
-    for (const auto &order : other.inProcessOrders)
-    {
-        inProcessOrders.push_back(new Order(*order));
-    }
-
-    // Deep copy completedOrders
-    for (const auto &order : other.completedOrders)
-    {
-        completedOrders.push_back(new Order(*order));
-    }
+    // Orders were copied by value with the table, point the queues at the copies
+    relinkOrderQueues(other);
 
     // Deep copy customers
     for (auto &customer : other.customers)
@@ -346,110 +707,92 @@ WareHouse &WareHouse::operator=(const WareHouse &other)
 {
     if (this != &other)
     { // Check for self-assignment
-        // Clear current data to avoid memory leaks
-        for (auto &action : actionsLog)
-        {
-            delete action;
-        }
-        actionsLog.clear();
-
-        for (auto &volunteer : volunteers)
-        {
-            delete volunteer;
-        }
-        volunteers.clear();
-
-        for (auto &order : pendingOrders)
-        {
-            delete order;
-        }
-        pendingOrders.clear();
-
-        for (auto &order : inProcessOrders)
-        {
-            delete order;
-        }
-        inProcessOrders.clear();
+        // Overwrite the existing objects in place wherever both states hold the same
+        // record, and only allocate or free the ones on one side alone
+        actionsLog = other.actionsLog;
+        volunteers = other.volunteers;
+        assignCustomers(other);
 
-        for (auto &order : completedOrders)
-        {
-            delete order;
-        }
-        completedOrders.clear();
-
-        for (auto &customer : customers)
-        {
-            delete customer;
-        }
-        customers.clear();
-
-        // Deep copy volunteers
-        for (const auto &volunteer : other.volunteers)
-        {
-            if (dynamic_cast<LimitedCollectorVolunteer *>(volunteer))
-                volunteers.push_back(new LimitedCollectorVolunteer(std::move(*dynamic_cast<LimitedCollectorVolunteer *>(volunteer))));
-            else if (dynamic_cast<CollectorVolunteer *>(volunteer))
-                volunteers.push_back(new CollectorVolunteer(std::move(*dynamic_cast<CollectorVolunteer *>(volunteer))));
-            if (dynamic_cast<LimitedDriverVolunteer *>(volunteer))
-                volunteers.push_back(new LimitedDriverVolunteer(std::move(*dynamic_cast<LimitedDriverVolunteer *>(volunteer))));
-            else if (dynamic_cast<DriverVolunteer *>(volunteer))
-                volunteers.push_back(new DriverVolunteer(std::move(*dynamic_cast<DriverVolunteer *>(volunteer))));
-        }
-
-        // Deep copy actionsLog
-        for (const auto &action : other.actionsLog)
-        {
-            actionsLog.push_back(action->clone());
-        }
-
-        // Deep copy pendingOrders
-        for (const auto &order : other.pendingOrders)
-        {
-            pendingOrders.push_back(new Order(*order));
-        }
+        // Copy the orders by value into the existing slots and point the queues at them
+        orders = other.orders;
+        relinkOrderQueues(other);
 
-        // Deep copy inProcessOrders
-        for (const auto &order : other.inProcessOrders)
-        {
-            inProcessOrders.push_back(new Order(*order));
-        }
-
-        // Deep copy completedOrders
-        for (const auto &order : other.completedOrders)
-        {
-            completedOrders.push_back(new Order(*order));
-        }
-
-        // Deep copy customers
-        for (auto &customer : other.customers)
-        {
-            if (dynamic_cast<SoldierCustomer *>(customer))
-                customers.push_back(new SoldierCustomer(std::move(*dynamic_cast<SoldierCustomer *>(customer))));
-            else if (dynamic_cast<CivilianCustomer *>(customer))
-                customers.push_back(new CivilianCustomer(std::move(*dynamic_cast<CivilianCustomer *>(customer))));
-        }
+        // The archive is flat, copying it is a handful of byte vectors
+        completedOrders = other.completedOrders;
 
         // Copy other counters
         isOpen = other.isOpen;
         customerCounter = other.customerCounter;
         volunteerCounter = other.volunteerCounter;
         orderCounter = other.orderCounter;
+        currentTick = other.currentTick;
+        summary = other.summary;
+        restoreCount++;
     }
     return *this;
 }
 
+// Customers are only ever appended, so both lists start with the same customers unless
+// one side went back to a checkpoint and added different ones under the same ids
+void WareHouse::assignCustomers(const WareHouse &other)
+{
+    size_t shorter = std::min(customers.size(), other.customers.size());
+    for (size_t i = 0; i < shorter; i++)
+    {
+        Customer *current = customers[i];
+        const Customer *customer = other.customers[i];
+        if (current->getId() == customer->getId() && typeid(*current) == typeid(*customer) &&
+            current->getNameId() == customer->getNameId() && current->getCustomerDistance() == customer->getCustomerDistance() &&
+            current->getMaxOrders() == customer->getMaxOrders())
+        {
+            current->setOrdersIds(customer->getOrdersIds());
+        }
+        else
+        {
+            delete current;
+            customers[i] = customer->clone();
+        }
+    }
+    for (size_t i = shorter; i < customers.size(); i++)
+    {
+        delete customers[i];
+    }
+    customers.resize(shorter);
+    for (size_t i = shorter; i < other.customers.size(); i++)
+    {
+        customers.push_back(other.customers[i]->clone());
+    }
+}
+
 // Move constructor
 WareHouse::WareHouse(WareHouse &&other) noexcept
     : isOpen(std::move(other.isOpen)),
       actionsLog(std::move(other.actionsLog)),
       volunteers(std::move(other.volunteers)),
+      orders(std::move(other.orders)),
       pendingOrders(std::move(other.pendingOrders)),
       inProcessOrders(std::move(other.inProcessOrders)),
+      pendingFrom(other.pendingFrom),
+      collectedFrom(other.collectedFrom),
       completedOrders(std::move(other.completedOrders)),
       customers(std::move(other.customers)),
       customerCounter(std::move(other.customerCounter)),
       volunteerCounter(std::move(other.volunteerCounter)),
-      orderCounter(std::move(other.orderCounter))
+      orderCounter(std::move(other.orderCounter)),
+      currentTick(std::move(other.currentTick)),
+      summary(other.summary),
+      intake(),
+      intakeBatch(),
+      stepsDrainIntake(true),
+      publisher(nullptr),
+      clock(nullptr),
+      profiler(nullptr),
+      tracer(nullptr),
+      checkpoints(),
+      backgroundSave(),
+      throughput(),
+      demand(),
+      restoreCount(other.restoreCount)
 {
 }
 
@@ -461,23 +804,50 @@ WareHouse &WareHouse::operator=(WareHouse &&other) noexcept
         isOpen = std::move(other.isOpen);
         actionsLog = std::move(other.actionsLog);
         volunteers = std::move(other.volunteers);
+        orders = std::move(other.orders);
         pendingOrders = std::move(other.pendingOrders);
         inProcessOrders = std::move(other.inProcessOrders);
+        pendingFrom = other.pendingFrom;
+        collectedFrom = other.collectedFrom;
         completedOrders = std::move(other.completedOrders);
         customers = std::move(other.customers);
         customerCounter = std::move(other.customerCounter);
         volunteerCounter = std::move(other.volunteerCounter);
         orderCounter = std::move(other.orderCounter);
+        currentTick = std::move(other.currentTick);
+        summary = other.summary;
+        restoreCount++;
 
         // Reset 'other' to a valid state
         other.isOpen = false;
         other.customerCounter = 0;
         other.volunteerCounter = 0;
         other.orderCounter = 0;
+        other.currentTick = 0;
+        other.summary = WareHouseSummary();
     }
     return *this;
 }
 
+// Rebuild the queues of a copied warehouse so they point into this table
+void WareHouse::relinkOrderQueues(const WareHouse &other)
+{
+    pendingOrders.clear();
+    pendingOrders.reserve(other.pendingOrders.size());
+    for (const Order *order : other.pendingOrders)
+    {
+        pendingOrders.push_back(orders.find(order->getId()));
+    }
+    inProcessOrders.clear();
+    inProcessOrders.reserve(other.inProcessOrders.size());
+    for (const Order *order : other.inProcessOrders)
+    {
+        inProcessOrders.push_back(orders.find(order->getId()));
+    }
+    pendingFrom = other.pendingFrom; // The same queues in the same order
+    collectedFrom = other.collectedFrom;
+}
+
 void WareHouse::close()
 {
     isOpen = false;
@@ -488,9 +858,18 @@ void WareHouse::open()
     isOpen = true;
 }
 
+bool WareHouse::isOpened() const
+{
+    return isOpen;
+}
+
 void WareHouse::addCustomer(Customer *customer)
 {
     customers.push_back(customer);
+    if (!customer->canMakeOrder())
+    {
+        summary.customersAtLimit++;
+    }
 }
 
 void WareHouse::addCustomer(const string &customerName, const string &customerType, int distance, int maxOrders)
@@ -508,60 +887,75 @@ void WareHouse::addCustomer(const string &customerName, const string &customerTy
     customerCounter++;
 }
 
-void WareHouse::addVolunteer(Volunteer *volunteer)
+// Add the volunteer of a configuration line with the next volunteer id
+// "wave <size>" after the arguments of a collector, 1 without it
+static int parseWaveSize(const vector<string> &tokens, size_t at)
 {
-    volunteers.push_back(volunteer);
+    if (tokens.size() < at + 2 || tokens[at] != "wave")
+        return 1;
+    int waveSize = stoi(tokens[at + 1]);
+    if (waveSize < 1)
+    {
+        throw std::invalid_argument("Wave size must be positive: " + tokens[at + 1]);
+    }
+    return waveSize;
+}
+
+void WareHouse::addVolunteer(const vector<string> &tokens)
+{
+    if (tokens[2] == "collector")
+    {
+        CollectorVolunteer collectorVolunteer(volunteerCounter, tokens[1], stoi(tokens[3]), parseWaveSize(tokens, 4));
+        addVolunteer(collectorVolunteer);
+    }
+    else if (tokens[2] == "limited_collector")
+    {
+        LimitedCollectorVolunteer limitedCollectorVolunteer(volunteerCounter, tokens[1], stoi(tokens[3]), stoi(tokens[4]), parseWaveSize(tokens, 5));
+        addVolunteer(limitedCollectorVolunteer);
+    }
+    else if (tokens[2] == "driver")
+    {
+        DriverVolunteer driverVolunteer(volunteerCounter, tokens[1], stoi(tokens[3]), stoi(tokens[4]));
+        addVolunteer(driverVolunteer);
+    }
+    else
+    {
+        LimitedDriverVolunteer limitedDriverVolunteer(volunteerCounter, tokens[1], stoi(tokens[3]), stoi(tokens[4]), stoi(tokens[5]));
+        addVolunteer(limitedDriverVolunteer);
+    }
+    volunteerCounter++;
+}
+
+void WareHouse::addVolunteer(const Volunteer &volunteer)
+{
+    volunteers.add(volunteer);
+}
+
+void WareHouse::replaceVolunteer(size_t index, const Volunteer &volunteer)
+{
+    volunteers.replace(index, volunteer);
 }
 
 int WareHouse::printOrderStatus(int orderId)
 {
-    for (const auto &order : pendingOrders)
+    string report;
+    const Order *order = orders.find(orderId);
+    ArchivedOrder archived;
+    if (order != nullptr)
     {
-        if (order->getId() == orderId)
-        {
-            std::cout << "OrderId: " << orderId << std::endl;
-            std::cout << "OrderStatus: " << order->getStatusString(order->getStatus()) << std::endl;
-            std::cout << "CustomerID: " << order->getCustomerId() << std::endl;
-            if (order->getCollectorId() == NO_VOLUNTEER)
-                std::cout << "Collector: None" << std::endl;
-            else
-                std::cout << "Collector: " << order->getCollectorId() << std::endl;
-            if (order->getDriverId() == NO_VOLUNTEER)
-                std::cout << "Driver: None" << std::endl;
-            else
-                std::cout << "Driver: " << order->getDriverId() << std::endl;
-            return 1;
-        }
+        Snapshot::appendOrderStatus(report, orderId, order->getStatus(), order->getCustomerId(), order->getCollectorId(), order->getDriverId());
     }
-    for (const auto &order : inProcessOrders)
+    else if (completedOrders.find(orderId, archived))
     {
-        if (order->getId() == orderId)
-        {
-            std::cout << "OrderId: " << orderId << std::endl;
-            std::cout << "OrderStatus: " << order->getStatusString(order->getStatus()) << std::endl;
-            std::cout << "CustomerID: " << order->getCustomerId() << std::endl;
-            std::cout << "Collector: " << order->getCollectorId() << std::endl;
-            if (order->getDriverId() == NO_VOLUNTEER)
-                std::cout << "Driver: None" << std::endl;
-            else
-                std::cout << "Driver: " << order->getDriverId() << std::endl;
-            return 1;
-        }
+        Snapshot::appendOrderStatus(report, orderId, OrderStatus::COMPLETED, archived.customerId, archived.collectorId, archived.driverId);
     }
-    for (const auto &order : completedOrders)
+    else
     {
-        if (order->getId() == orderId)
-        {
-            std::cout << "OrderId: " << orderId << std::endl;
-            std::cout << "OrderStatus: " << order->getStatusString(order->getStatus()) << std::endl;
-            std::cout << "CustomerID: " << order->getCustomerId() << std::endl;
-            std::cout << "Collector: " << order->getCollectorId() << std::endl;
-            std::cout << "Driver: " << order->getDriverId() << std::endl;
-            return 1;
-        }
+        // If order is not found in any of the lists
+        return -1;
     }
-    // If order is not found in any of the lists
-    return -1;
+    output << report;
+    return 1;
 }
 
 int WareHouse::printCustomerStatus(int customerId)
@@ -584,23 +978,19 @@ int WareHouse::printCustomerStatus(int customerId)
     }
 
     // Print customer ID
-    std::cout << "CustomerID: " << customerId << std::endl;
+    output << "CustomerID: " << customerId << '\n';
 
     // Print orders and their statuses
-    const vector<int> &orders = customer->getOrdersIds();
-    for (int orderId : orders)
+    string report;
+    for (int orderId : customer->getOrdersIds())
     {
-        Order *order = &getOrder(orderId);
-        if (order != nullptr)
-        {
-            std::cout << "OrderID: " << order->getId() << std::endl;
-            std::cout << "OrderStatus: " << order->getStatusString(order->getStatus()) << std::endl;
-        }
+        Snapshot::appendOrderLine(report, orderId, getOrderStatus(orderId));
     }
+    output << report;
 
     // Print number of orders left
     int numOrdersLeft = customer->getMaxOrders() - customer->getNumOrders();
-    std::cout << "numOrdersLeft: " << numOrdersLeft << std::endl;
+    output << "numOrdersLeft: " << numOrdersLeft << '\n';
 
     return 1;
 }
@@ -646,168 +1036,330 @@ int WareHouse::printVolunteerStatus(int volunteerId)
         return -1;
     }
 
-    std::cout << "VolunteerID: " << volunteerId << std::endl;
-    std::cout << "isBusy: " << (volunteer->isBusy() ? "True" : "False") << std::endl;
+    string report;
+    Snapshot::appendVolunteerStatus(report, getVolunteerRecord(volunteer));
+    output << report;
+    return 1;
+}
 
-    int instanceOfVolunteer = getInstanceOfVolunteer(volunteer);
+VolunteerRecord WareHouse::getVolunteerRecord(const Volunteer *volunteer) const
+{
+    VolunteerTimers timers = volunteer->getTimers();
+    return VolunteerRecord{volunteer->getId(), timers.activeOrderId, timers.timeLeft, timers.ordersLeft};
+}
 
-    // If volunteer is busy, print the order ID he is currently processing
-    if (volunteer->isBusy())
-    {
-        std::cout << "OrderID: " << volunteer->getActiveOrderId() << std::endl;
-        // Check if the volunteer is a Collector or a Driver based on instanceOfVolunteer
-        if (instanceOfVolunteer == 1 || instanceOfVolunteer == 2)
-        {
-            // Assuming Collector role
-            std::cout << "TimeLeft: " << dynamic_cast<CollectorVolunteer *>(volunteer)->getTimeLeft() << std::endl;
-        }
+// Offer the order to one volunteer, returns its id if it took the order and NO_VOLUNTEER
+// otherwise. The calls are qualified with the concrete type, so they bind statically
+static int offerOrder(VolunteerSlot &slot, const Order &order)
+{
+    return std::visit([&order](auto &volunteer) {
+        using Type = std::decay_t<decltype(volunteer)>;
+        if (!volunteer.Type::canTakeOrder(order))
+            return NO_VOLUNTEER;
+        volunteer.Type::acceptOrder(order);
+        return volunteer.getId();
+    }, slot);
+}
+
+// Orders that can still join the wave the collector in the slot just started
+static int waveRoom(const VolunteerSlot &slot)
+{
+    return std::visit([](const auto &volunteer) {
+        using Type = std::decay_t<decltype(volunteer)>;
+        if constexpr (std::is_base_of_v<CollectorVolunteer, Type>)
+            return volunteer.Type::getWaveRoom();
         else
-        {
-            // Assuming Driver role
-            std::cout << "TimeLeft: " << dynamic_cast<DriverVolunteer *>(volunteer)->getDistanceLeft() << std::endl;
-        }
-    }
+            return 0;
+    }, slot);
+}
 
-    else
-    {
-        std::cout << "OrderID: None" << std::endl;
-        std::cout << "TimeLeft: None" << std::endl;
-    }
+static int joinWave(VolunteerSlot &slot, const Order &order)
+{
+    return std::visit([&order](auto &volunteer) {
+        using Type = std::decay_t<decltype(volunteer)>;
+        if constexpr (std::is_base_of_v<CollectorVolunteer, Type>)
+            volunteer.Type::joinWave(order);
+        return volunteer.getId();
+    }, slot);
+}
 
-    // Checking if this is a limited volunteer
-    int ordersLeft = 0;
-    if (instanceOfVolunteer == 2)
-    {
-        ordersLeft = dynamic_cast<LimitedCollectorVolunteer *>(volunteer)->getNumOrdersLeft();
-        std::cout << "OrdersLeft: " << ordersLeft << std::endl;
-    }
-    else if (instanceOfVolunteer == 4)
-    {
-        ordersLeft = dynamic_cast<LimitedDriverVolunteer *>(volunteer)->getNumOrdersLeft();
-        std::cout << "OrdersLeft: " << ordersLeft << std::endl;
-    }
-    else
-    {
-        std::cout << "OrdersLeft: No limit" << std::endl;
-    }
+static bool isCollectorSlot(const VolunteerSlot &slot)
+{
+    return std::holds_alternative<CollectorVolunteer>(slot) || std::holds_alternative<LimitedCollectorVolunteer>(slot);
+}
 
-    return 1;
+// Whether the volunteer could take some order now: collectors take any order when they
+// are free, drivers any order within their reach
+static bool isAvailable(const VolunteerSlot &slot)
+{
+    return std::visit([](const auto &volunteer) {
+        using Type = std::decay_t<decltype(volunteer)>;
+        return !volunteer.isBusy() && volunteer.Type::hasOrdersLeft();
+    }, slot);
 }
 
-// Helper function to assign orders to volunteers based on their status
+// Helper function to assign orders to volunteers based on their status.
+// Orders are offered in queue order to the volunteers in list order, as they always were.
+// Counting the available volunteers first lets the pass end once none is left for the
+// orders still ahead, and a volunteer that cannot take any order is not offered the
+// ones after it. Once only one kind of order can be taken, the pass jumps ahead to where
+// pendingFrom or collectedFrom say the first of that kind may be. The orders that stay
+// are compacted in place, not erased one by one. A collector with a wave size above 1 starts a wave
+// with the order it takes, and the pending orders after it join that wave, up to the
+// size, before the next collector is offered any
 void WareHouse::assignOrdersToVolunteers()
 {
-    auto it = pendingOrders.begin();
-    while (it != pendingOrders.end())
+    vector<VolunteerSlot> &slots = volunteers.getSlots();
+    int availableCollectors = 0;
+    int availableDrivers = 0;
+    for (const VolunteerSlot &slot : slots)
     {
-        Order *order = *it;
+        if (isAvailable(slot))
+            (isCollectorSlot(slot) ? availableCollectors : availableDrivers)++;
+    }
+    size_t firstCollector = 0; // Slots before these cannot take an order in this pass
+    size_t firstDriver = 0;
+    size_t waveSlot = 0; // The collector whose wave the next pending orders join
+    int openWaveRoom = 0;  // How many more can join it
+
+    // The queue holds pending orders and collected ones waiting for a driver
+    int unseenPending = summary.pendingOrders;
+    int unseenCollected = static_cast<int>(pendingOrders.size()) - unseenPending;
+
+    size_t kept = 0;
+    size_t next = 0;
+    size_t firstKeptPending = pendingOrders.size(); // Where the first kept order of each kind went
+    size_t firstKeptCollected = pendingOrders.size();
+    while (next < pendingOrders.size())
+    {
+        bool takingPending = (availableCollectors > 0 || openWaveRoom > 0) && unseenPending > 0;
+        bool takingCollected = availableDrivers > 0 && unseenCollected > 0;
+        if (!takingPending && !takingCollected)
+            break;
+
+        // When only one kind of order can be taken, jump to where the first of that kind may be
+        size_t from = !takingCollected ? pendingFrom : !takingPending ? collectedFrom : next;
+        from = std::min(from, pendingOrders.size());
+        if (from > next)
+        {
+            size_t &firstKept = takingPending ? firstKeptCollected : firstKeptPending;
+            firstKept = std::min(firstKept, kept);
+            (takingPending ? unseenCollected : unseenPending) -= static_cast<int>(from - next);
+            if (kept != next)
+                std::move(pendingOrders.begin() + next, pendingOrders.begin() + from, pendingOrders.begin() + kept);
+            kept += from - next;
+            next = from;
+            continue;
+        }
+
+        Order *order = pendingOrders[next++];
         OrderStatus currentOrderStatus = order->getStatus();
-        if (currentOrderStatus == OrderStatus::PENDING)
+        (currentOrderStatus == OrderStatus::PENDING ? unseenPending : unseenCollected)--;
+        bool assigned = false;
+        if (currentOrderStatus == OrderStatus::PENDING && openWaveRoom > 0)
+        {
+            // Collected in the cooldown the wave's first order started
+            int collectorId = joinWave(slots[waveSlot], *order);
+            openWaveRoom--;
+            order->setCollectorId(collectorId);
+            order->setStatus(OrderStatus::COLLECTING);
+            summary.pendingOrders--;
+            summary.collectingOrders++;
+            if (tracer != nullptr)
+                tracer->order(*order, collectorId, currentTick);
+            assigned = true;
+        }
+        else if (currentOrderStatus == OrderStatus::PENDING && availableCollectors > 0)
         {
-            for (auto &volunteer : volunteers)
+            for (size_t i = firstCollector; i < slots.size(); i++)
             {
-                int instanceOfVolunteer = getInstanceOfVolunteer(volunteer);
                 // Check if the volunteer is a Collector / limitedCollector
-                if (instanceOfVolunteer == 1 || instanceOfVolunteer == 2)
+                if (!isCollectorSlot(slots[i]))
+                    continue;
+                int collectorId = offerOrder(slots[i], *order);
+                if (collectorId != NO_VOLUNTEER)
                 {
-                    if (volunteer->canTakeOrder(*order))
-                    {
-                        volunteer->acceptOrder(*order);
-                        order->setCollectorId(volunteer->getId());
-                        order->setStatus(OrderStatus::COLLECTING);
-
-                        inProcessOrders.push_back(std::move(order));
-                        it = pendingOrders.erase(it); // Remove the order from pendingOrders
-                        break;                        // Exit the loop after assigning the order
-                    }
+                    // Collectors turn an order down only when they cannot take any
+                    firstCollector = i + 1;
+                    availableCollectors--;
+                    waveSlot = i;
+                    openWaveRoom = waveRoom(slots[i]);
+                    order->setCollectorId(collectorId);
+                    order->setStatus(OrderStatus::COLLECTING);
+                    summary.pendingOrders--;
+                    summary.collectingOrders++;
+                    summary.busyVolunteers++;
+                    if (tracer != nullptr)
+                        tracer->order(*order, collectorId, currentTick);
+                    assigned = true;
+                    break; // Exit the loop after assigning the order
                 }
             }
-            if (order->getCollectorId() == NO_VOLUNTEER)
-                ++it;
         }
-        else if (currentOrderStatus == OrderStatus::COLLECTING)
+        else if (currentOrderStatus == OrderStatus::COLLECTING && availableDrivers > 0)
         {
-            for (auto &volunteer : volunteers)
+            bool unavailableSoFar = true;
+            for (size_t i = firstDriver; i < slots.size(); i++)
             {
-                int instanceOfVolunteer = getInstanceOfVolunteer(volunteer);
                 // Check if the volunteer is a Driverr / limitedDriver
-                if (instanceOfVolunteer == 3 || instanceOfVolunteer == 4)
+                if (isCollectorSlot(slots[i]))
                 {
-                    if (volunteer->canTakeOrder(*order))
-                    {
-                        volunteer->acceptOrder(*order);
-                        order->setDriverId(volunteer->getId());
-                        order->setStatus(OrderStatus::DELIVERING);
-
-                        inProcessOrders.push_back(std::move(order));
-                        it = pendingOrders.erase(it); // Remove the order from pendingOrders
-                        break;                        // Exit the loop after assigning the order
-                    }
+                    if (unavailableSoFar)
+                        firstDriver = i + 1;
+                    continue;
                 }
+                int driverId = offerOrder(slots[i], *order);
+                if (driverId != NO_VOLUNTEER)
+                {
+                    if (unavailableSoFar)
+                        firstDriver = i + 1;
+                    availableDrivers--;
+                    order->setDriverId(driverId);
+                    order->setStatus(OrderStatus::DELIVERING);
+                    summary.collectingOrders--;
+                    summary.deliveringOrders++;
+                    summary.busyVolunteers++;
+                    if (tracer != nullptr)
+                        tracer->order(*order, driverId, currentTick);
+                    assigned = true;
+                    break; // Exit the loop after assigning the order
+                }
+                // A driver may turn down a far order and take a near one
+                if (unavailableSoFar && !isAvailable(slots[i]))
+                    firstDriver = i + 1;
+                else
+                    unavailableSoFar = false;
             }
-            if (order->getDriverId() == NO_VOLUNTEER)
-                ++it;
+        }
+
+        if (assigned)
+        {
+            inProcessOrders.push_back(order);
         }
         else
         {
-            ++it; // Move to the next order if it's not pending or collecting
+            size_t &firstKept = currentOrderStatus == OrderStatus::PENDING ? firstKeptPending : firstKeptCollected;
+            firstKept = std::min(firstKept, kept);
+            pendingOrders[kept++] = order;
         }
     }
+
+    // The orders not reached stay where they are, after the ones kept
+    size_t removed = next - kept;
+    pendingFrom = std::min(firstKeptPending, pendingFrom > next ? pendingFrom - removed : kept);
+    collectedFrom = std::min(firstKeptCollected, collectedFrom > next ? collectedFrom - removed : kept);
+    pendingOrders.erase(pendingOrders.begin() + kept, pendingOrders.begin() + next);
 }
 
 // Helper function to perform a step in the simulation
 void WareHouse::performSimulationStep()
 {
-    for (auto &volunteer : volunteers)
+    int finished = 0;
+    for (VolunteerSlot &slot : volunteers.getSlots())
     {
-        volunteer->step();
+        finished += std::visit([](auto &volunteer) {
+            using Type = std::decay_t<decltype(volunteer)>;
+            bool wasBusy = volunteer.isBusy();
+            volunteer.Type::step();
+            return wasBusy && !volunteer.isBusy();
+        }, slot);
     }
+    summary.busyVolunteers -= finished;
+}
+
+// The volunteer at this index. Volunteers are looked up by index with their id, as the
+// original code did; once deletions shrink the list an id can point past its end, where
+// the slot still refers to the volunteer it last held
+const Volunteer *WareHouse::volunteerAtIndex(int volunteerIndex) const
+{
+    if (static_cast<size_t>(volunteerIndex) < volunteers.size())
+    {
+        return volunteers[volunteerIndex];
+    }
+    int staleId = volunteers.staleId(volunteerIndex);
+    for (const Volunteer *volunteer : volunteers)
+    {
+        if (volunteer->getId() == staleId)
+            return volunteer;
+    }
+    return nullptr;
+}
+
+// The completed order of the volunteer at this index
+int WareHouse::finishedOrder(int volunteerIndex) const
+{
+    const Volunteer *volunteer = volunteerAtIndex(volunteerIndex);
+    return volunteer != nullptr ? volunteer->getCompletedOrderId() : NO_ORDER;
+}
+
+// Whether the order joined a wave its collector finished in this step. A collector has
+// one wave at a time and all of it leaves in the step it is done, so an order it is
+// still collecting is in that wave. Only the order's own collector counts
+bool WareHouse::finishedWave(int volunteerIndex, const Order &order) const
+{
+    if (order.getStatus() != OrderStatus::COLLECTING)
+        return false;
+    const Volunteer *collector = volunteerAtIndex(volunteerIndex);
+    return collector != nullptr && collector->getId() == order.getCollectorId() && collector->getCompletedOrderId() != NO_ORDER;
 }
 
 // Helper function to check if volunteers have finished their orders
 void WareHouse::checkVolunteerFinishedOrders()
 {
-    auto it = inProcessOrders.begin();
-    while (it != inProcessOrders.end())
+    // Orders still in process are compacted in place, keeping their order
+    size_t kept = 0;
+    for (size_t i = 0; i < inProcessOrders.size(); i++)
     {
-        Order *order = *it;
+        Order *order = inProcessOrders[i];
         int collectorId = order->getCollectorId();
         int driverId = order->getDriverId();
-        if (collectorId != NO_VOLUNTEER && volunteers[collectorId]->getCompletedOrderId() == order->getId())
+        if (collectorId != NO_VOLUNTEER && (finishedOrder(collectorId) == order->getId() || finishedWave(collectorId, *order)))
         {
-            pendingOrders.push_back(std::move(order));
-            it = inProcessOrders.erase(it);
+            collectedFrom = std::min(collectedFrom, pendingOrders.size());
+            pendingOrders.push_back(order);
+            throughput.orderCollected();
         }
-        else if (driverId != NO_VOLUNTEER && volunteers[driverId]->getCompletedOrderId() == order->getId())
+        else if (driverId != NO_VOLUNTEER && finishedOrder(driverId) == order->getId())
         {
+            // Completed orders leave the live table for the archive
             order->setStatus(OrderStatus::COMPLETED);
-            completedOrders.push_back(std::move(order));
-            it = inProcessOrders.erase(it);
+            summary.deliveringOrders--;
+            summary.completedOrders++;
+            throughput.orderDelivered();
+            if (tracer != nullptr)
+                tracer->order(*order, driverId, currentTick);
+            completedOrders.append(*order, currentTick);
+            orders.retire(order->getId());
         }
         else
         {
-            ++it;
+            inProcessOrders[kept++] = order;
         }
     }
+    inProcessOrders.resize(kept);
 }
 
 // Helper function to delete volunteers who have reached maxOrders limit
 void WareHouse::deleteMaxOrdersVolunteers()
 {
-    for (auto it = volunteers.begin(); it != volunteers.end();)
+    vector<VolunteerSlot> &slots = volunteers.getSlots();
+    for (size_t i = 0; i < slots.size();)
     {
-        if ((*it)->hasOrdersLeft())
+        bool hasOrdersLeft = std::visit([](const auto &volunteer) {
+            using Type = std::decay_t<decltype(volunteer)>;
+            return volunteer.Type::hasOrdersLeft();
+        }, slots[i]);
+        if (hasOrdersLeft)
         {
-            ++it;
+            ++i;
         }
-        else if ((*it)->getActiveOrderId() != NO_ORDER)
+        else if (volunteers[i]->getActiveOrderId() != NO_ORDER)
         {
-            ++it;
+            ++i;
         }
         else
         {
-            delete *it;
-            it = volunteers.erase(it);
+            volunteers.erase(i);
         }
     }
 }
@@ -816,20 +1368,80 @@ void WareHouse::simulateStep(int numberOfSteps)
 {
     for (int step = 0; step < numberOfSteps; ++step)
     {
+        // Step boundary: take in orders and customers submitted meanwhile
+        ProfileScope phase(profiler, tracer, currentTick, ProfilePhase::DRAIN);
+        if (stepsDrainIntake)
+            drainIntake();
+        if (demand.isActive())
+            demand.generate(*this);
+
         // Assign orders to volunteers based on their status
+        phase.next(ProfilePhase::ASSIGN);
         assignOrdersToVolunteers();
+        int workingVolunteers = summary.busyVolunteers;
+        int volunteerCount = static_cast<int>(volunteers.size());
 
         // Perform a step in the simulation
+        phase.next(ProfilePhase::STEP);
         performSimulationStep();
 
         // Check if volunteers have finished their orders
+        phase.next(ProfilePhase::FINISH);
         checkVolunteerFinishedOrders();
 
         // Delete volunteers who have reached maxOrders limit
+        phase.next(ProfilePhase::DELETE);
         deleteMaxOrdersVolunteers();
+
+        throughput.endTick(workingVolunteers, volunteerCount);
+        currentTick++;
+
+        // Step boundary: let readers on other threads see the new state
+        phase.next(ProfilePhase::PUBLISH);
+        if (publisher != nullptr)
+        {
+            publisher->publishIfStale(*this);
+        }
     }
 }
 
+IntakeQueue &WareHouse::getIntake()
+{
+    return intake;
+}
+
+int WareHouse::drainIntake(vector<IntakeOutcome> *outcomes)
+{
+    if (intake.empty())
+    {
+        return 0;
+    }
+    intake.drain(intakeBatch);
+    for (const IntakeRequest &request : intakeBatch)
+    {
+        if (outcomes != nullptr)
+        {
+            outcomes->push_back(IntakeOutcome{request.producerId, request.sequence, string()});
+            output.beginCapture(outcomes->back().printed);
+        }
+        if (request.kind == IntakeKind::ORDER)
+        {
+            AddOrder action(request.customerId);
+            action.act(*this);
+        }
+        else
+        {
+            AddCustomer action(NameTable::lookup(request.name), request.soldier ? "soldier" : "civilian", request.distance, request.maxOrders);
+            action.act(*this);
+        }
+        if (outcomes != nullptr)
+        {
+            output.endCapture();
+        }
+    }
+    return static_cast<int>(intakeBatch.size());
+}
+
 void WareHouse::readConfigAndSetup(const string &configFilePath)
 {
     std::ifstream inputFile(configFilePath);
@@ -879,27 +1491,7 @@ void WareHouse::readConfigAndSetup(const string &configFilePath)
         // Create a new volunteer
         if (tokens[0] == "volunteer")
         {
-            if (tokens[2] == "collector")
-            {
-                CollectorVolunteer *collectorVolunteer = new CollectorVolunteer(volunteerCounter, tokens[1], stoi(tokens[3]));
-                addVolunteer(collectorVolunteer);
-            }
-            else if (tokens[2] == "limited_collector")
-            {
-                LimitedCollectorVolunteer *limitedCollectorVolunteer = new LimitedCollectorVolunteer(volunteerCounter, tokens[1], stoi(tokens[3]), stoi(tokens[4]));
-                addVolunteer(limitedCollectorVolunteer);
-            }
-            else if (tokens[2] == "driver")
-            {
-                DriverVolunteer *driverVolunteer = new DriverVolunteer(volunteerCounter, tokens[1], stoi(tokens[3]), stoi(tokens[4]));
-                addVolunteer(driverVolunteer);
-            }
-            else
-            {
-                LimitedDriverVolunteer *limitedDriverVolunteer = new LimitedDriverVolunteer(volunteerCounter, tokens[1], stoi(tokens[3]), stoi(tokens[4]), stoi(tokens[5]));
-                addVolunteer(limitedDriverVolunteer);
-            }
-            volunteerCounter++;
+            addVolunteer(tokens);
         }
     }
     /* Prints all the Volunteers and the Customers fron the config file
@@ -1,21 +1,106 @@
 #include "../include/WareHouse.h"
+#include "../include/Server.h"
+#include "../include/SimulationClock.h"
+#include "../include/Profiler.h"
+#include "../include/Tracer.h"
+#include "../include/Network.h"
+#include "../include/Partition.h"
 #include <iostream>
+#include <memory>
 
 using namespace std;
 
 WareHouse* backup = nullptr;
 
 int main(int argc, char** argv){
-    if(argc!=2){
-        std::cout << "usage: warehouse <config_path>" << std::endl;
+    string socketPath;
+    int ticksPerSecond = -1; // No background clock
+    string profilePath;
+    string tracePath;
+    int partitions = 0; // One process
+    if(argc>=3 && string(argv[1])=="--network"){
+        // Network mode: one warehouse per configuration file, orders routed between them
+        WareHouseNetwork network(vector<string>(argv+2, argv+argc));
+        network.start();
+        return 0;
+    }
+    bool validArgs = argc>=2 && argc%2==0;
+    for(int i=2; validArgs && i<argc; i+=2){
+        string option = argv[i];
+        if(option=="--socket")
+            socketPath = argv[i+1];
+        else if(option=="--clock")
+            ticksPerSecond = atoi(argv[i+1]);
+        else if(option=="--profile")
+            profilePath = argv[i+1];
+        else if(option=="--trace")
+            tracePath = argv[i+1];
+        else if(option=="--partitions")
+            partitions = atoi(argv[i+1]);
+        else
+            validArgs = false;
+    }
+    if(partitions>0 && (!socketPath.empty() || ticksPerSecond>=0 || !profilePath.empty() || !tracePath.empty()))
+        validArgs = false;
+    if(!validArgs){
+        std::cout << "usage: warehouse <config_path> [--socket <socket_path>] [--clock <ticks_per_second, 0 for as fast as possible>] [--profile <csv_path>] [--trace <json_path>] [--partitions <processes>]\n       warehouse --network <config_path> <config_path>..." << std::endl;
         return 0;
     }
     string configurationFile = argv[1];
+    if(partitions>0){
+        // Partitioned mode: worker processes hold the warehouse, this one coordinates them
+        PartitionedWareHouse partitioned(configurationFile, partitions);
+        partitioned.start();
+        return 0;
+    }
     WareHouse wareHouse(configurationFile);
-    wareHouse.start();
+    unique_ptr<SimulationClock> clock;
+    if(ticksPerSecond>=0){
+        // Background clock: the warehouse advances on its own between commands
+        clock.reset(new SimulationClock(wareHouse, ticksPerSecond));
+        wareHouse.setClock(clock.get());
+    }
+    unique_ptr<Profiler> profiler;
+    if(!profilePath.empty()){
+        // Hardware counters around every step phase and command, written out on exit
+        profiler.reset(new Profiler());
+        wareHouse.setProfiler(profiler.get());
+    }
+    unique_ptr<Tracer> tracer;
+    if(!tracePath.empty()){
+        // Ticks, phases and order changes as Chrome trace JSON, written out on exit
+        tracer.reset(new Tracer());
+        wareHouse.setTracer(tracer.get());
+    }
+    if(!socketPath.empty()){
+        // Server mode: commands come from clients of a Unix domain socket
+        Server server(wareHouse, socketPath);
+        wareHouse.open();
+        if(clock)
+            clock->start();
+        std::cout << "Warehouse is open on " << socketPath << std::endl;
+        server.run();
+    }
+    else{
+        wareHouse.start();
+    }
+    if(clock){
+        clock->stop();
+        wareHouse.setClock(nullptr);
+    }
+    if(profiler){
+        wareHouse.setProfiler(nullptr);
+        if(!profiler->dump(profilePath))
+            std::cerr << "Cannot write profile: " << profilePath << std::endl;
+    }
+    if(tracer){
+        wareHouse.setTracer(nullptr);
+        if(!tracer->dump(tracePath))
+            std::cerr << "Cannot write trace: " << tracePath << std::endl;
+    }
     if(backup!=nullptr){
     	delete backup;
     	backup = nullptr;
     }
     return 0;
-}
\ No newline at end of file
+}